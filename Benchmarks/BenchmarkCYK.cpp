@@ -0,0 +1,92 @@
+#include "Benchmarks.hpp"
+#include "GrammarFamilies.hpp"
+
+#include <benchmark/benchmark.h>
+#include <FL/BatchRecognizer.hpp>
+#include <FL/CYK.hpp>
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace FL {
+
+namespace {
+
+size_t const bracketTypeCount = 2;
+size_t const wordPoolSize = 64;
+size_t const batchWordCount = 2048;
+
+CYK const& dyckCYK() {
+    static CYK const cyk(dyckGrammar(bracketTypeCount));
+    return cyk;
+}
+
+std::vector<std::string> makeWords(size_t size, size_t acceptedPercent, size_t count) {
+    std::mt19937 random(static_cast<unsigned>(size * 101 + acceptedPercent));
+    std::vector<std::string> words;
+    for (size_t i = 0; i < count; ++i) {
+        words.push_back(
+            i * 100 < acceptedPercent * count ?
+                dyckWord(size, bracketTypeCount, random) :
+                nonDyckWord(size, bracketTypeCount, random)
+        );
+    }
+    std::shuffle(words.begin(), words.end(), random);
+    return words;
+}
+
+void predict(benchmark::State& state) {
+    auto const& cyk = dyckCYK();
+    auto words = makeWords(state.range(0), state.range(1), wordPoolSize);
+    CYK::Workspace workspace;
+    size_t index = state.thread_index();
+    size_t acceptedCount = 0;
+    for (auto _: state) {
+        acceptedCount += cyk.predict(words[index++ % words.size()], workspace);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+    state.counters["acceptance"] = benchmark::Counter(
+        static_cast<double>(acceptedCount),
+        benchmark::Counter::kAvgIterations
+    );
+}
+
+void predictBatch(benchmark::State& state) {
+    BatchOptions options;
+    options.threadCount = state.range(1);
+    options.chunkSize = 16 * 1024;
+    BatchRecognizer recognizer(dyckCYK(), options);
+
+    std::string text;
+    for (auto const& word: makeWords(state.range(0), 50, batchWordCount)) {
+        text += word + '\n';
+    }
+    for (auto _: state) {
+        std::istringstream input(text);
+        auto report = recognizer.run(input, [](std::vector<std::uint8_t> const&) {});
+        benchmark::DoNotOptimize(report);
+    }
+    state.SetItemsProcessed(state.iterations() * batchWordCount);
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+
+}
+
+void registerCYKBenchmarks() {
+    benchmark::RegisterBenchmark("Predict/Dyck", predict)
+        ->ArgNames({"length", "acceptedPercent"})
+        ->ArgsProduct({{16, 64, 256}, {0, 50, 100}})
+        ->ThreadRange(1, 4)
+        ->UseRealTime()
+        ->Unit(benchmark::kMicrosecond);
+    benchmark::RegisterBenchmark("PredictBatch/Dyck", predictBatch)
+        ->ArgNames({"length", "threads"})
+        ->ArgsProduct({{16, 64}, {1, 2, 4}})
+        ->UseRealTime()
+        ->Unit(benchmark::kMillisecond);
+}
+
+}
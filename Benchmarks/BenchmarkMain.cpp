@@ -0,0 +1,23 @@
+#include "Benchmarks.hpp"
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+
+int main(int argc, char* argv[]) {
+    std::string format = "--benchmark_format=json";
+    std::vector<char*> arguments{argv[0], format.data()};
+    arguments.insert(arguments.end(), argv + 1, argv + argc);
+    auto argumentCount = static_cast<int>(arguments.size());
+
+    benchmark::Initialize(&argumentCount, arguments.data());
+    if (benchmark::ReportUnrecognizedArguments(argumentCount, arguments.data())) {
+        return 1;
+    }
+    FL::registerNormalizationBenchmarks();
+    FL::registerCYKBenchmarks();
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    return 0;
+}
@@ -0,0 +1,159 @@
+#include "Benchmarks.hpp"
+#include "GrammarFamilies.hpp"
+
+#include <benchmark/benchmark.h>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace FL {
+
+namespace {
+
+class PhaseGrammar: public ContextFreeGrammar {
+public:
+    static constexpr char const* phaseNames[] = {
+        "RemoveLongRules",
+        "RemoveEmptyRules",
+        "RemoveChainRules",
+        "RemoveNonGeneratingRules",
+        "RemoveNonReachableRules",
+        "RemoveMixedRules"
+    };
+
+    explicit PhaseGrammar(ContextFreeGrammar const& grammar);
+
+    void runPhase(size_t phase);
+};
+
+struct GrammarFamily {
+    std::string name;
+    std::function<ContextFreeGrammar(std::int64_t, std::int64_t)> make;
+    std::vector<std::string> argumentNames;
+    std::vector<std::vector<std::int64_t>> arguments;
+};
+
+PhaseGrammar::PhaseGrammar(ContextFreeGrammar const& grammar):
+    ContextFreeGrammar(grammar)
+{}
+
+void PhaseGrammar::runPhase(size_t phase) {
+    switch (phase) {
+    case 0:
+        removeLongRules();
+        break;
+    case 1:
+        removeEmptyRules();
+        break;
+    case 2:
+        removeChainRules();
+        break;
+    case 3:
+        removeNonGeneratingRules();
+        break;
+    case 4:
+        removeNonReachableRules();
+        break;
+    default:
+        removeMixedRules();
+        break;
+    }
+}
+
+std::vector<GrammarFamily> const& grammarFamilies() {
+    static std::vector<GrammarFamily> const families{
+        {
+            "PrecedenceLadder",
+            [](std::int64_t levelCount, std::int64_t) {
+                return precedenceLadder(levelCount);
+            },
+            {"levels"},
+            {{4}, {16}, {64}}
+        },
+        {
+            "RandomCNF",
+            [](std::int64_t nonterminalCount, std::int64_t ruleCount) {
+                return randomCNF(nonterminalCount, ruleCount, 1);
+            },
+            {"nonterminals", "rules"},
+            {{16, 64}, {16, 256}, {64, 256}, {64, 1024}, {256, 4096}}
+        },
+        {
+            "Dyck",
+            [](std::int64_t bracketTypeCount, std::int64_t) {
+                return dyckGrammar(bracketTypeCount);
+            },
+            {"types"},
+            {{1}, {2}, {4}}
+        },
+        {
+            "Ambiguous",
+            [](std::int64_t maxRuleSize, std::int64_t) {
+                return ambiguousGrammar(maxRuleSize);
+            },
+            {"maxRuleSize"},
+            {{2}, {4}, {8}, {16}}
+        }
+    };
+    return families;
+}
+
+ContextFreeGrammar makeGrammar(GrammarFamily const& family, benchmark::State const& state) {
+    return family.make(state.range(0), family.argumentNames.size() > 1 ? state.range(1) : 0);
+}
+
+void setGrammarCounters(benchmark::State& state, ContextFreeGrammar const& grammar) {
+    state.counters["nonterminals"] = grammar.nonterminals().size();
+    state.counters["rules"] = grammar.rules().size();
+}
+
+void normalize(benchmark::State& state, GrammarFamily const& family) {
+    auto grammar = makeGrammar(family, state);
+    for (auto _: state) {
+        auto normalizedGrammar = grammar.normalized();
+        benchmark::DoNotOptimize(normalizedGrammar);
+    }
+    setGrammarCounters(state, grammar);
+}
+
+void normalizationPhase(benchmark::State& state, GrammarFamily const& family, size_t phase) {
+    PhaseGrammar grammar(makeGrammar(family, state));
+    for (size_t i = 0; i < phase; ++i) {
+        grammar.runPhase(i);
+    }
+    for (auto _: state) {
+        state.PauseTiming();
+        auto phaseGrammar = grammar;
+        state.ResumeTiming();
+        phaseGrammar.runPhase(phase);
+        benchmark::DoNotOptimize(phaseGrammar);
+    }
+    setGrammarCounters(state, grammar);
+}
+
+void addArguments(benchmark::internal::Benchmark* benchmark, GrammarFamily const& family) {
+    for (auto const& arguments: family.arguments) {
+        benchmark->Args(arguments);
+    }
+    benchmark->ArgNames(family.argumentNames)->Unit(benchmark::kMicrosecond);
+}
+
+}
+
+void registerNormalizationBenchmarks() {
+    for (auto const& family: grammarFamilies()) {
+        addArguments(
+            benchmark::RegisterBenchmark(("Normalize/" + family.name).c_str(), normalize, family),
+            family
+        );
+        for (size_t phase = 0; phase < std::size(PhaseGrammar::phaseNames); ++phase) {
+            auto name = std::string(PhaseGrammar::phaseNames[phase]) + "/" + family.name;
+            addArguments(
+                benchmark::RegisterBenchmark(name.c_str(), normalizationPhase, family, phase),
+                family
+            );
+        }
+    }
+}
+
+}
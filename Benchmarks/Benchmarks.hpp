@@ -0,0 +1,8 @@
+#pragma once
+
+namespace FL {
+
+void registerNormalizationBenchmarks();
+void registerCYKBenchmarks();
+
+}
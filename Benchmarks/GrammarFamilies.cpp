@@ -0,0 +1,129 @@
+#include "GrammarFamilies.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace FL {
+
+namespace {
+
+int const firstNonterminal = 256;
+std::string const operators = "+-*/%^&|<>=!~?:;,.@$#";
+std::string const brackets = "()[]{}<>";
+
+Alphabet makeNonterminals(size_t count) {
+    Alphabet nonterminals;
+    for (size_t i = 0; i < count; ++i) {
+        nonterminals.emplace(firstNonterminal + static_cast<int>(i));
+    }
+    return nonterminals;
+}
+
+Symbol nonterminal(size_t index) {
+    return Symbol(firstNonterminal + static_cast<int>(index));
+}
+
+size_t bracketPairCount(size_t bracketTypeCount) {
+    return std::clamp<size_t>(bracketTypeCount, 1, brackets.size() / 2);
+}
+
+}
+
+ContextFreeGrammar precedenceLadder(size_t levelCount) {
+    Alphabet terminals{'a', '(', ')'};
+    std::vector<Grammar::Rule> rules;
+    for (size_t level = 0; level < levelCount; ++level) {
+        auto operation = operators[level % operators.size()];
+        terminals.insert(operation);
+        rules.emplace_back(
+            Word{nonterminal(level)},
+            Word{nonterminal(level), operation, nonterminal(level + 1)}
+        );
+        rules.emplace_back(Word{nonterminal(level)}, Word{nonterminal(level + 1)});
+    }
+    rules.emplace_back(Word{nonterminal(levelCount)}, Word{'(', nonterminal(0), ')'});
+    rules.emplace_back(Word{nonterminal(levelCount)}, Word{'a'});
+    return ContextFreeGrammar(terminals, makeNonterminals(levelCount + 1), nonterminal(0), rules);
+}
+
+ContextFreeGrammar randomCNF(size_t nonterminalCount, size_t ruleCount, unsigned seed) {
+    std::mt19937 random(seed);
+    std::string const letters = "abcd";
+    nonterminalCount = std::max<size_t>(nonterminalCount, 1);
+    std::uniform_int_distribution<size_t> nonterminals(0, nonterminalCount - 1);
+    std::uniform_int_distribution<size_t> terminals(0, letters.size() - 1);
+
+    std::vector<Grammar::Rule> rules;
+    for (size_t i = 0; i < ruleCount; ++i) {
+        if (i < nonterminalCount) {
+            rules.emplace_back(Word{nonterminal(i)}, Word{letters[terminals(random)]});
+        } else {
+            rules.emplace_back(
+                Word{nonterminal(nonterminals(random))},
+                Word{nonterminal(nonterminals(random)), nonterminal(nonterminals(random))}
+            );
+        }
+    }
+    return ContextFreeGrammar(
+        Alphabet(letters.begin(), letters.end()),
+        makeNonterminals(nonterminalCount),
+        nonterminal(0),
+        rules
+    );
+}
+
+ContextFreeGrammar dyckGrammar(size_t bracketTypeCount) {
+    Alphabet terminals;
+    std::vector<Grammar::Rule> rules{
+        {Word{nonterminal(0)}, Word{nonterminal(0), nonterminal(0)}},
+        {Word{nonterminal(0)}, Word{}}
+    };
+    for (size_t i = 0; i < bracketPairCount(bracketTypeCount); ++i) {
+        auto opening = brackets[2 * i];
+        auto closing = brackets[2 * i + 1];
+        terminals.insert({opening, closing});
+        rules.emplace_back(Word{nonterminal(0)}, Word{opening, nonterminal(0), closing});
+    }
+    return ContextFreeGrammar(terminals, makeNonterminals(1), nonterminal(0), rules);
+}
+
+ContextFreeGrammar ambiguousGrammar(size_t maxRuleSize) {
+    std::vector<Grammar::Rule> rules{
+        {Word{nonterminal(0)}, Word{'a'}},
+        {Word{nonterminal(0)}, Word{'b'}}
+    };
+    for (size_t size = 2; size <= maxRuleSize; ++size) {
+        rules.emplace_back(Word{nonterminal(0)}, Word(size, nonterminal(0)));
+    }
+    return ContextFreeGrammar({'a', 'b'}, makeNonterminals(1), nonterminal(0), rules);
+}
+
+std::string dyckWord(size_t size, size_t bracketTypeCount, std::mt19937& random) {
+    std::uniform_int_distribution<size_t> pairs(0, bracketPairCount(bracketTypeCount) - 1);
+    std::bernoulli_distribution opens(0.5);
+    std::string word;
+    std::vector<char> closings;
+    size &= ~size_t(1);
+    while (word.size() < size) {
+        auto canOpen = closings.size() + 2 <= size - word.size();
+        if (canOpen && (closings.empty() || opens(random))) {
+            auto pair = pairs(random);
+            word += brackets[2 * pair];
+            closings.push_back(brackets[2 * pair + 1]);
+        } else {
+            word += closings.back();
+            closings.pop_back();
+        }
+    }
+    return word;
+}
+
+std::string nonDyckWord(size_t size, size_t bracketTypeCount, std::mt19937& random) {
+    auto word = dyckWord(std::max<size_t>(size, 2), bracketTypeCount, random);
+    auto& symbol = word[std::uniform_int_distribution<size_t>(0, word.size() - 1)(random)];
+    auto position = brackets.find(symbol);
+    symbol = brackets[position ^ 1];
+    return word;
+}
+
+}
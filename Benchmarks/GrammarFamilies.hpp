@@ -0,0 +1,17 @@
+#pragma once
+
+#include <FL/ContextFreeGrammar.hpp>
+#include <random>
+#include <string>
+
+namespace FL {
+
+ContextFreeGrammar precedenceLadder(size_t levelCount);
+ContextFreeGrammar randomCNF(size_t nonterminalCount, size_t ruleCount, unsigned seed);
+ContextFreeGrammar dyckGrammar(size_t bracketTypeCount);
+ContextFreeGrammar ambiguousGrammar(size_t maxRuleSize);
+
+std::string dyckWord(size_t size, size_t bracketTypeCount, std::mt19937& random);
+std::string nonDyckWord(size_t size, size_t bracketTypeCount, std::mt19937& random);
+
+}
@@ -1,46 +1,334 @@
 #include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <memory>
+#include <stdexcept>
+#include <csignal>
+#include <FL/BatchRecognizer.hpp>
 #include <FL/ContextFreeGrammar.hpp>
+#include <FL/RecognitionServer.hpp>
 #include <FL/CYK.hpp>
+#include <FL/SearchCYK.hpp>
+#include <FL/WordGenerator.hpp>
+#include "GrammarFile.hpp"
 
-int main() {
-    using namespace FL;
+namespace {
 
-    char inputSeparator = '^';
-    std::cout << "(Use " << inputSeparator << " to end input)" << std::endl;
-    std::cout << "Terminals: ";
-    Alphabet terminals;
-    char symbol;
-    while (std::cin >> symbol && symbol != inputSeparator) {
-        terminals.insert(symbol);
+using namespace FL;
+
+RecognitionServer* activeServer = nullptr;
+
+CYK makeCYK(std::string const& grammarPath, std::string const& cachePath) {
+    auto grammar = loadGrammar(grammarPath);
+    return cachePath.empty() ? CYK(grammar) : CYK::loadOrCompile(grammar, cachePath);
+}
+
+int search(std::vector<std::string> const& arguments) {
+    SearchOptions options;
+    std::string cachePath;
+    std::vector<std::string> paths;
+    for (size_t i = 0; i < arguments.size(); ++i) {
+        if (arguments[i] == "--all") {
+            options.semantics = MatchSemantics::All;
+        } else if (arguments[i] == "--max-length" && i + 1 < arguments.size()) {
+            options.maxMatchSize = std::stoul(arguments[++i]);
+        } else if (arguments[i] == "--cache" && i + 1 < arguments.size()) {
+            cachePath = arguments[++i];
+        } else {
+            paths.push_back(arguments[i]);
+        }
+    }
+    if (paths.empty() || paths.size() > 2) {
+        std::cerr << "Usage: flp search [--all] [--max-length N] [--cache PATH] GRAMMAR [FILE]";
+        std::cerr << std::endl;
+        return 1;
+    }
+
+    std::ifstream textFile;
+    if (paths.size() == 2) {
+        textFile.open(paths[1], std::ios::binary);
+        if (!textFile) {
+            std::cerr << "Could not open " << paths[1] << std::endl;
+            return 1;
+        }
+    }
+
+    SearchCYK searcher(makeCYK(paths[0], cachePath), options);
+    searcher.search(paths.size() == 2 ? textFile : std::cin, [](Match const& match) {
+        std::cout << match.offset << '\t' << match.size << '\n';
+    });
+    return 0;
+}
+
+int batch(std::vector<std::string> const& arguments) {
+    BatchOptions options;
+    std::string grammarPath;
+    std::string inputPath;
+    std::string cachePath;
+    bool isSummaryOnly = false;
+    for (size_t i = 0; i < arguments.size(); ++i) {
+        if (arguments[i] == "--grammar" && i + 1 < arguments.size()) {
+            grammarPath = arguments[++i];
+        } else if (arguments[i] == "--input" && i + 1 < arguments.size()) {
+            inputPath = arguments[++i];
+        } else if (arguments[i] == "--threads" && i + 1 < arguments.size()) {
+            options.threadCount = std::stoul(arguments[++i]);
+        } else if (arguments[i] == "--cache" && i + 1 < arguments.size()) {
+            cachePath = arguments[++i];
+        } else if (arguments[i] == "--summary") {
+            isSummaryOnly = true;
+        } else {
+            grammarPath.clear();
+            break;
+        }
+    }
+    if (grammarPath.empty()) {
+        std::cerr << "Usage: flp --grammar GRAMMAR [--input FILE] [--threads N] [--cache PATH] ";
+        std::cerr << "[--summary]" << std::endl;
+        return 1;
+    }
+
+    std::ifstream inputFile;
+    if (!inputPath.empty() && inputPath != "-") {
+        inputFile.open(inputPath, std::ios::binary);
+        if (!inputFile) {
+            std::cerr << "Could not open " << inputPath << std::endl;
+            return 1;
+        }
+    }
+
+    auto cyk = makeCYK(grammarPath, cachePath);
+    BatchRecognizer recognizer(cyk, options);
+    std::string output;
+    BatchRecognizer::ResultHandler handler;
+    if (!isSummaryOnly) {
+        handler = [&output](std::vector<std::uint8_t> const& results) {
+            output.clear();
+            for (auto isAccepted: results) {
+                output += isAccepted ? "accept\n" : "reject\n";
+            }
+            std::cout.write(output.data(), output.size());
+        };
+    }
+    auto report = recognizer.run(inputFile.is_open() ? inputFile : std::cin, handler);
+    std::cout.flush();
+
+    auto microseconds = [](double nanoseconds) {
+        return nanoseconds / 1000;
+    };
+    std::cerr << std::fixed << std::setprecision(3);
+    std::cerr << "words: " << report.wordCount;
+    std::cerr << ", accepted: " << report.acceptedCount;
+    std::cerr << ", rejected: " << report.wordCount - report.acceptedCount;
+    std::cerr << ", threads: " << recognizer.threadCount() << '\n';
+    std::cerr << "time: " << report.seconds << " s";
+    if (report.seconds > 0) {
+        std::cerr << ", " << report.wordCount / report.seconds << " words/s";
+        std::cerr << ", " << report.byteCount / report.seconds / (1 << 20) << " MiB/s";
+    }
+    std::cerr << '\n';
+    std::pair<char const*, double> const percentiles[] = {{"p50", 0.5}, {"p90", 0.9}, {"p99", 0.99}};
+    std::cerr << "latency (us): mean " << microseconds(report.latencies.mean());
+    for (auto [name, fraction]: percentiles) {
+        std::cerr << ", " << name << ' ' << microseconds(report.latencies.percentile(fraction));
+    }
+    std::cerr << ", max " << microseconds(report.latencies.max()) << std::endl;
+    if constexpr (instrumentationEnabled) {
+        std::cerr << CYKCounters::snapshot().toText() << std::flush;
+    }
+    return 0;
+}
+
+int generate(std::vector<std::string> const& arguments) {
+    CorpusOptions options;
+    options.minWordSize = 1;
+    options.maxWordSize = 16;
+    std::string grammarPath;
+    std::string outputPath;
+    std::string cachePath;
+    bool isVerified = false;
+    for (size_t i = 0; i < arguments.size(); ++i) {
+        if (arguments[i] == "--grammar" && i + 1 < arguments.size()) {
+            grammarPath = arguments[++i];
+        } else if (arguments[i] == "--count" && i + 1 < arguments.size()) {
+            options.wordCount = std::stoul(arguments[++i]);
+        } else if (arguments[i] == "--min-length" && i + 1 < arguments.size()) {
+            options.minWordSize = std::stoul(arguments[++i]);
+        } else if (arguments[i] == "--max-length" && i + 1 < arguments.size()) {
+            options.maxWordSize = std::stoul(arguments[++i]);
+        } else if (arguments[i] == "--negative-ratio" && i + 1 < arguments.size()) {
+            options.negativeRatio = std::stod(arguments[++i]);
+        } else if (arguments[i] == "--threads" && i + 1 < arguments.size()) {
+            options.threadCount = std::stoul(arguments[++i]);
+        } else if (arguments[i] == "--seed" && i + 1 < arguments.size()) {
+            options.seed = std::stoull(arguments[++i]);
+        } else if (arguments[i] == "--output" && i + 1 < arguments.size()) {
+            outputPath = arguments[++i];
+        } else if (arguments[i] == "--cache" && i + 1 < arguments.size()) {
+            cachePath = arguments[++i];
+        } else if (arguments[i] == "--labels") {
+            options.writesLabels = true;
+        } else if (arguments[i] == "--verify") {
+            isVerified = true;
+        } else {
+            grammarPath.clear();
+            break;
+        }
+    }
+    if (grammarPath.empty() || options.minWordSize > options.maxWordSize) {
+        std::cerr << "Usage: flp generate --grammar GRAMMAR --count N [--min-length N] ";
+        std::cerr << "[--max-length N] [--negative-ratio R] [--labels] [--threads N] [--seed N] ";
+        std::cerr << "[--output FILE] [--verify] [--cache PATH]" << std::endl;
+        return 1;
     }
 
-    std::cout << "Nonterminals: ";
-    Alphabet nonterminals;
-    while (std::cin >> symbol && symbol != inputSeparator) {
-        nonterminals.insert(symbol);
+    std::ofstream outputFile;
+    if (!outputPath.empty() && outputPath != "-") {
+        outputFile.open(outputPath, std::ios::binary);
+        if (!outputFile) {
+            std::cerr << "Could not open " << outputPath << std::endl;
+            return 1;
+        }
+    }
+
+    auto grammar = loadGrammar(grammarPath);
+    WordGenerator generator(grammar, options.maxWordSize + 1);
+    std::unique_ptr<CYK> verifier;
+    isVerified = isVerified || (options.writesLabels && options.negativeRatio > 0);
+    if (isVerified) {
+        verifier = std::make_unique<CYK>(makeCYK(grammarPath, cachePath));
+    }
+    auto& output = outputFile.is_open() ? static_cast<std::ostream&>(outputFile) : std::cout;
+    auto report = generator.writeCorpus(output, options, verifier.get());
+    output.flush();
+
+    std::cerr << std::fixed << std::setprecision(3);
+    std::cerr << "words: " << report.wordCount;
+    std::cerr << ", negative: " << report.negativeCount;
+    if (isVerified) {
+        std::cerr << ", rejected mutations: " << report.rejectedMutationCount;
+    }
+    std::cerr << '\n';
+    std::cerr << "time: " << report.seconds << " s";
+    if (report.seconds > 0) {
+        std::cerr << ", " << report.wordCount / report.seconds << " words/s";
+        std::cerr << ", " << report.byteCount / report.seconds / (1 << 20) << " MiB/s";
     }
+    std::cerr << std::endl;
+    return 0;
+}
 
-    std::cout << "Start symbol: ";
-    std::cin >> symbol;
-    Symbol startSymbol = symbol;
+int profile(std::vector<std::string> const& arguments) {
+    if (arguments.size() != 1) {
+        std::cerr << "Usage: flp profile GRAMMAR" << std::endl;
+        return 1;
+    }
 
-    std::cout << "Rules (lhs[space]rhs|<eps>): ";
-    std::string lhs;
-    std::string rhs;
-    std::vector<Grammar::Rule> rules;
-    while (std::cin >> lhs && lhs != std::string(1, inputSeparator)) {
-        std::cin >> rhs;
-        if (rhs == "<eps>") {
-            rhs.clear();
+    auto grammar = loadGrammar(arguments[0]);
+    NormalizationReport report;
+    grammar.normalize(&report);
+    std::cout << report.toText();
+    return 0;
+}
+
+int serve(std::vector<std::string> const& arguments) {
+    ServerOptions options;
+    std::vector<std::pair<std::string, std::string>> grammars;
+    for (size_t i = 0; i < arguments.size(); ++i) {
+        if (arguments[i] == "--socket" && i + 1 < arguments.size()) {
+            options.socketPath = arguments[++i];
+        } else if (arguments[i] == "--threads" && i + 1 < arguments.size()) {
+            options.threadCount = std::stoul(arguments[++i]);
+        } else if (arguments[i] == "--batch-size" && i + 1 < arguments.size()) {
+            options.maxBatchSize = std::stoul(arguments[++i]);
+        } else if (arguments[i] == "--batch-delay-us" && i + 1 < arguments.size()) {
+            options.batchDelay = std::chrono::microseconds(std::stoul(arguments[++i]));
+        } else if (arguments[i].find('=') != std::string::npos) {
+            size_t separator = arguments[i].find('=');
+            grammars.emplace_back(
+                arguments[i].substr(0, separator),
+                arguments[i].substr(separator + 1)
+            );
+        } else {
+            grammars.clear();
+            break;
         }
-        rules.emplace_back(lhs, rhs);
     }
+    if (options.socketPath.empty() || grammars.empty()) {
+        std::cerr << "Usage: flp serve --socket PATH [--threads N] [--batch-size N] ";
+        std::cerr << "[--batch-delay-us N] NAME=GRAMMAR..." << std::endl;
+        return 1;
+    }
+
+    RecognitionServer server(options);
+    for (auto const& [name, path]: grammars) {
+        server.addGrammar(name, [path = path] {
+            return loadGrammar(path);
+        });
+    }
+    activeServer = &server;
+    for (auto signalNumber: {SIGINT, SIGTERM}) {
+        std::signal(signalNumber, [](int) {
+            activeServer->stop();
+        });
+    }
+    std::cerr << "Listening on " << options.socketPath << std::endl;
+    server.run();
+    activeServer = nullptr;
+    return 0;
+}
+
+int client(std::vector<std::string> const& arguments) {
+    if (arguments.size() != 2 || arguments[0] != "--socket") {
+        std::cerr << "Usage: flp client --socket PATH < REQUESTS" << std::endl;
+        return 1;
+    }
+
+    RecognitionClient client(arguments[1]);
+    std::vector<std::string> requests;
+    std::string line;
+    while (std::getline(std::cin, line)) {
+        requests.push_back(line);
+    }
+    for (auto const& response: client.request(requests)) {
+        std::cout << response << '\n';
+    }
+    return 0;
+}
+
+}
 
-    std::string word;
+int main(int argc, char** argv) {
+    std::vector<std::string> arguments(argv + 1, argv + argc);
     try {
-        ContextFreeGrammar grammar(terminals, nonterminals, startSymbol, rules);
+        if (!arguments.empty() && arguments[0] == "search") {
+            return search(std::vector<std::string>(arguments.begin() + 1, arguments.end()));
+        }
+        if (!arguments.empty() && arguments[0] == "generate") {
+            std::ios::sync_with_stdio(false);
+            return generate(std::vector<std::string>(arguments.begin() + 1, arguments.end()));
+        }
+        if (!arguments.empty() && arguments[0] == "profile") {
+            return profile(std::vector<std::string>(arguments.begin() + 1, arguments.end()));
+        }
+        if (!arguments.empty() && arguments[0] == "serve") {
+            return serve(std::vector<std::string>(arguments.begin() + 1, arguments.end()));
+        }
+        if (!arguments.empty() && arguments[0] == "client") {
+            return client(std::vector<std::string>(arguments.begin() + 1, arguments.end()));
+        }
+        if (!arguments.empty()) {
+            std::ios::sync_with_stdio(false);
+            return batch(arguments);
+        }
+
+        std::cout << "(Use " << inputSeparator << " to end input)" << std::endl;
+        auto grammar = readGrammar(std::cin, &std::cout);
         CYK cyk(grammar);
 
+        std::string word;
         for (;;) {
             std::cout << "Word to test: ";
             std::cin >> word;
@@ -50,6 +338,7 @@ int main() {
             std::cout << (cyk.predict(word) ? "accept" : "reject") << std::endl;
         }
     } catch(std::exception const& exception) {
-        std::cout << exception.what() << std::endl;
+        std::cerr << exception.what() << std::endl;
+        return 1;
     }
 }
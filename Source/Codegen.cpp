@@ -0,0 +1,58 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <FL/CodeGenerator.hpp>
+#include "GrammarFile.hpp"
+
+namespace {
+
+using namespace FL;
+
+int generate(std::vector<std::string> const& arguments) {
+    CodeGeneratorOptions options;
+    std::string grammarPath;
+    std::string outputPath;
+    for (size_t i = 0; i < arguments.size(); ++i) {
+        if (arguments[i] == "--grammar" && i + 1 < arguments.size()) {
+            grammarPath = arguments[++i];
+        } else if (arguments[i] == "--output" && i + 1 < arguments.size()) {
+            outputPath = arguments[++i];
+        } else if (arguments[i] == "--namespace" && i + 1 < arguments.size()) {
+            options.namespaceName = arguments[++i];
+        } else {
+            throw std::runtime_error("Unknown argument " + arguments[i]);
+        }
+    }
+    if (grammarPath.empty()) {
+        std::cerr << "Usage: flp-codegen --grammar PATH [--output PATH] [--namespace NAME]" <<
+            std::endl;
+        return 1;
+    }
+
+    CodeGenerator generator(loadGrammar(grammarPath), options);
+    if (outputPath.empty()) {
+        generator.write(std::cout);
+    } else {
+        std::ofstream output(outputPath);
+        if (!output) {
+            throw std::runtime_error("Could not open " + outputPath);
+        }
+        generator.write(output);
+    }
+    std::cerr << generator.nonterminalCount() << " nonterminals, " <<
+        generator.binaryRuleCount() << " binary rules" << std::endl;
+    return 0;
+}
+
+}
+
+int main(int argc, char** argv) {
+    try {
+        return generate(std::vector<std::string>(argv + 1, argv + argc));
+    } catch(std::exception const& exception) {
+        std::cerr << exception.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,157 @@
+#include "BatchRecognizer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <mutex>
+#include <string_view>
+#include <thread>
+
+namespace FL {
+
+BatchRecognizer::BatchRecognizer(CYK const& cyk, BatchOptions const& options):
+    _cyk(cyk),
+    _options(options)
+{
+    _options.chunkSize = std::max<size_t>(_options.chunkSize, 1);
+    _options.chunksPerThread = std::max<size_t>(_options.chunksPerThread, 1);
+}
+
+BatchOptions const& BatchRecognizer::options() const {
+    return _options;
+}
+
+size_t BatchRecognizer::threadCount() const {
+    if (_options.threadCount) {
+        return _options.threadCount;
+    }
+    return std::max<size_t>(std::thread::hardware_concurrency(), 1);
+}
+
+BatchReport BatchRecognizer::run(std::istream& input, ResultHandler handler) const {
+    auto startTime = std::chrono::steady_clock::now();
+    BatchReport report;
+    size_t threadCount = this->threadCount();
+    std::vector<Chunk> chunks(threadCount * _options.chunksPerThread);
+    std::vector<CYK::Workspace> workspaces(threadCount);
+    std::string rest;
+
+    for (;;) {
+        size_t chunkCount = readChunks(input, chunks, rest);
+        if (!chunkCount) {
+            break;
+        }
+
+        std::atomic<size_t> nextChunk{0};
+        std::exception_ptr exception;
+        std::mutex exceptionMutex;
+        auto work = [&](CYK::Workspace& workspace) {
+            try {
+                for (size_t i; (i = nextChunk++) < chunkCount;) {
+                    recognize(chunks[i], workspace);
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(exceptionMutex);
+                exception = std::current_exception();
+            }
+        };
+        std::vector<std::thread> threads;
+        for (size_t i = 1; i < std::min(threadCount, chunkCount); ++i) {
+            threads.emplace_back(work, std::ref(workspaces[i]));
+        }
+        work(workspaces[0]);
+        for (auto& thread: threads) {
+            thread.join();
+        }
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+
+        for (size_t i = 0; i < chunkCount; ++i) {
+            report.wordCount += chunks[i].results.size();
+            report.acceptedCount += chunks[i].acceptedCount;
+            report.byteCount += chunks[i].text.size();
+            report.latencies.merge(chunks[i].latencies);
+            if (handler) {
+                handler(chunks[i].results);
+            }
+        }
+    }
+
+    report.seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - startTime
+    ).count();
+    return report;
+}
+
+size_t BatchRecognizer::readChunks(
+    std::istream& input,
+    std::vector<Chunk>& chunks,
+    std::string& rest
+) const {
+    size_t chunkCount = 0;
+    while (chunkCount < chunks.size()) {
+        auto& text = chunks[chunkCount].text;
+        text.swap(rest);
+        rest.clear();
+
+        size_t lastNewline = std::string::npos;
+        for (;;) {
+            size_t size = text.size();
+            text.resize(size + _options.chunkSize);
+            input.read(&text[size], _options.chunkSize);
+            text.resize(size + input.gcount());
+            if (!input) {
+                break;
+            }
+            lastNewline = text.rfind('\n');
+            if (lastNewline != std::string::npos) {
+                break;
+            }
+        }
+
+        if (input) {
+            rest.assign(text, lastNewline + 1);
+            text.resize(lastNewline + 1);
+        }
+        if (text.empty()) {
+            break;
+        }
+        ++chunkCount;
+        if (!input) {
+            break;
+        }
+    }
+    return chunkCount;
+}
+
+void BatchRecognizer::recognize(Chunk& chunk, CYK::Workspace& workspace) const {
+    chunk.results.clear();
+    chunk.latencies.clear();
+    chunk.acceptedCount = 0;
+
+    auto const& text = chunk.text;
+    for (size_t wordStart = 0; wordStart < text.size();) {
+        size_t wordEnd = std::min(text.find('\n', wordStart), text.size());
+        size_t nextWordStart = wordEnd + 1;
+        if (wordEnd > wordStart && text[wordEnd - 1] == '\r') {
+            --wordEnd;
+        }
+
+        auto startTime = std::chrono::steady_clock::now();
+        bool isAccepted = _cyk.predict(
+            std::string_view(text.data() + wordStart, wordEnd - wordStart),
+            workspace
+        );
+        chunk.latencies.record(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - startTime
+        ).count());
+
+        chunk.results.push_back(isAccepted);
+        chunk.acceptedCount += isAccepted;
+        wordStart = nextWordStart;
+    }
+}
+
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "CYK.hpp"
+#include "LatencyHistogram.hpp"
+#include <istream>
+#include <functional>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace FL {
+
+struct BatchOptions {
+    size_t threadCount = 0;
+    size_t chunkSize = 256 * 1024;
+    size_t chunksPerThread = 4;
+};
+
+struct BatchReport {
+    size_t wordCount = 0;
+    size_t acceptedCount = 0;
+    size_t byteCount = 0;
+    double seconds = 0;
+    LatencyHistogram latencies;
+};
+
+class BatchRecognizer {
+public:
+    using ResultHandler = std::function<void(std::vector<std::uint8_t> const& results)>;
+
+    explicit BatchRecognizer(CYK const& cyk, BatchOptions const& options = {});
+
+    BatchOptions const& options() const;
+    size_t threadCount() const;
+    BatchReport run(std::istream& input, ResultHandler handler) const;
+
+protected:
+    struct Chunk {
+        std::string text;
+        std::vector<std::uint8_t> results;
+        LatencyHistogram latencies;
+        size_t acceptedCount = 0;
+    };
+
+    size_t readChunks(std::istream& input, std::vector<Chunk>& chunks, std::string& rest) const;
+    void recognize(Chunk& chunk, CYK::Workspace& workspace) const;
+
+    CYK const& _cyk;
+    BatchOptions _options;
+};
+
+}
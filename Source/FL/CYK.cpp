@@ -1,112 +1,884 @@
 #include "CYK.hpp"
 
-#include <unordered_map>
-#include <iostream>
+#include <algorithm>
 
 namespace FL {
 
-CYK::CYK(ContextFreeGrammar const& grammar):
-    _grammar(grammar.normalized())
+namespace {
+
+constexpr std::uint64_t hashBase = 1000003;
+constexpr std::uint64_t hashMixer = 0x9e3779b97f4a7c15;
+constexpr size_t tileBytes = 32 * 1024;
+constexpr size_t minTileSize = 8;
+constexpr size_t cellsPerInterruptionCheck = 256;
+constexpr size_t progressReportsPerPrediction = 1000;
+
+bool containsBit(std::uint64_t const* values, size_t index) {
+    return (values[index / bitsPerCellWord] >> (index % bitsPerCellWord)) & 1;
+}
+
+void insertBit(std::uint64_t* values, size_t index) {
+    values[index / bitsPerCellWord] |= std::uint64_t(1) << (index % bitsPerCellWord);
+}
+
+std::uint64_t subwordHash(
+    std::uint64_t const* prefixHashes,
+    std::uint64_t power,
+    size_t subwordStart,
+    size_t subwordSize
+) {
+    return prefixHashes[subwordStart + subwordSize] - prefixHashes[subwordStart] * power;
+}
+
+}
+
+void CancellationToken::cancel() {
+    _isCancelled.store(true, std::memory_order_relaxed);
+}
+
+bool CancellationToken::isCancelled() const {
+    return _isCancelled.load(std::memory_order_relaxed);
+}
+
+CYK::Monitor::Monitor(PredictionLimits const& limits, size_t cellCount):
+    _limits(limits),
+    _cellCount(cellCount),
+    _computedCellCount(0),
+    _reportedCellCount(0),
+    _isInterrupted(false)
+{}
+
+bool CYK::Monitor::isInterrupted() const {
+    return _isInterrupted;
+}
+
+bool CYK::Monitor::proceed(size_t computedCellCount) {
+    _computedCellCount += computedCellCount;
+    if (
+        _limits.progressHandler &&
+        _computedCellCount > _reportedCellCount &&
+        (
+            (_computedCellCount - _reportedCellCount) * progressReportsPerPrediction >= _cellCount ||
+            _computedCellCount == _cellCount
+        )
+    ) {
+        _reportedCellCount = _computedCellCount;
+        _limits.progressHandler(static_cast<double>(_computedCellCount) / _cellCount);
+    }
+
+    _isInterrupted = (
+        (_limits.cancellationToken && _limits.cancellationToken->isCancelled()) ||
+        (
+            _computedCellCount < _cellCount &&
+            _limits.deadline != std::chrono::steady_clock::time_point::max() &&
+            std::chrono::steady_clock::now() >= _limits.deadline
+        )
+    );
+    return !_isInterrupted;
+}
+
+size_t CYK::Workspace::allocationCount() const {
+    return _allocationCount;
+}
+
+size_t CYK::Workspace::capacity() const {
+    return (
+        _cells.size() * sizeof(std::uint64_t) +
+        _rowOffsets.size() * sizeof(std::ptrdiff_t) +
+        _columnOffsets.size() * sizeof(std::ptrdiff_t) +
+        _prefixHashes.size() * sizeof(std::uint64_t) +
+        _equalSubwords.size() * sizeof(size_t) +
+        _hashSlots.size() * sizeof(size_t) +
+        _scratchCells.size()
+    );
+}
+
+CYKCounters const& CYK::Workspace::counters() const {
+    return _counters;
+}
+
+std::uint64_t* CYK::Workspace::reserveScratchFile(std::string const& directory, size_t size) {
+    size *= sizeof(std::uint64_t);
+    if (_scratchCells.size() < size) {
+        ++_allocationCount;
+        _scratchCells.map(directory, size);
+    } else {
+        _scratchCells.clear();
+    }
+    return static_cast<std::uint64_t*>(_scratchCells.data());
+}
+
+CYK::Table::Table(
+    std::uint64_t* cells,
+    std::ptrdiff_t const* rowOffsets,
+    std::ptrdiff_t const* columnOffsets,
+    size_t wordSize,
+    size_t cellSize,
+    ScratchFile const* scratchFile,
+    CYKCounters* counters
+):
+    _cells(cells),
+    _rowOffsets(rowOffsets),
+    _columnOffsets(columnOffsets),
+    _wordSize(wordSize),
+    _cellSize(cellSize),
+    _scratchFile(scratchFile),
+    _counters(counters)
 {}
 
+size_t CYK::Table::wordSize() const {
+    return _wordSize;
+}
+
+bool CYK::Table::isOutOfCore() const {
+    return _scratchFile != nullptr;
+}
+
+CYKCounters* CYK::Table::counters() const {
+    return _counters;
+}
+
+void CYK::Table::prefetch(size_t subwordStart, size_t subwordEnd, size_t cellCount) const {
+    if (_scratchFile) {
+        _scratchFile->prefetch(
+            cell(subwordStart, subwordEnd),
+            cellCount * _cellSize * sizeof(std::uint64_t)
+        );
+    }
+}
+
+std::uint64_t* CYK::Table::cell(size_t subwordStart, size_t subwordEnd) {
+    return _cells + (_rowOffsets[subwordStart] + _columnOffsets[subwordEnd]) * _cellSize;
+}
+
+std::uint64_t const* CYK::Table::cell(size_t subwordStart, size_t subwordEnd) const {
+    return _cells + (_rowOffsets[subwordStart] + _columnOffsets[subwordEnd]) * _cellSize;
+}
+
+bool CYK::Table::contains(size_t nonterminal, size_t subwordStart, size_t subwordEnd) const {
+    return containsBit(cell(subwordStart, subwordEnd), nonterminal);
+}
+
+CYK::CYK(ContextFreeGrammar const& grammar, CYKOptions const& options):
+    _sourceGrammar(std::make_shared<ContextFreeGrammar const>(grammar)),
+    _grammar(std::make_shared<ContextFreeGrammar const>(grammar.normalized())),
+    _options(options)
+{
+    compileRules();
+}
+
+CYK::CYK(CompiledGrammarReader& reader, CYKOptions const& options):
+    _sourceGrammar(std::make_shared<ContextFreeGrammar const>(reader.readGrammar())),
+    _grammar(std::make_shared<ContextFreeGrammar const>(reader.readGrammar())),
+    _options(options),
+    _nonterminals(reader.readWord())
+{
+    for (size_t i = 0; i < _nonterminals.size(); ++i) {
+        _nonterminalIndices[_nonterminals[i]] = i;
+    }
+    _cellSize = reader.readValue();
+    _startIndex = reader.readValue();
+    _acceptsEmptyWord = reader.readValue();
+    if (_cellSize != (_nonterminals.size() + bitsPerCellWord - 1) / bitsPerCellWord) {
+        throw CompiledGrammarException();
+    }
+
+    size_t terminalCount = reader.readValue();
+    for (size_t i = 0; i < terminalCount; ++i) {
+        auto terminal = reader.readSymbol();
+        auto values = reader.read(_cellSize);
+        _terminalCells[terminal].assign(values, values + _cellSize);
+    }
+
+    size_t ruleIndexSize = reader.readValue();
+    auto rulesByLeftChild = reader.read(ruleIndexSize);
+    _rulesByLeftChild.assign(rulesByLeftChild, rulesByLeftChild + ruleIndexSize);
+    size_t binaryRuleCount = reader.readValue();
+    auto binaryRules = reader.read(2 * binaryRuleCount);
+    for (size_t i = 0; i < binaryRuleCount; ++i) {
+        _binaryRules.push_back({binaryRules[2 * i], binaryRules[2 * i + 1]});
+    }
+    if (
+        _startIndex >= _nonterminals.size() ||
+        _rulesByLeftChild.size() != _nonterminals.size() + 1 ||
+        _rulesByLeftChild.front() != 0 ||
+        _rulesByLeftChild.back() != _binaryRules.size() ||
+        !std::is_sorted(_rulesByLeftChild.begin(), _rulesByLeftChild.end())
+    ) {
+        throw CompiledGrammarException();
+    }
+    for (auto const& [rightChild, parent]: _binaryRules) {
+        if (rightChild >= _nonterminals.size() || parent >= _nonterminals.size()) {
+            throw CompiledGrammarException();
+        }
+    }
+}
+
+CYK::CYK(
+    ContextFreeGrammar const& sourceGrammar,
+    ContextFreeGrammar const& normalizedGrammar,
+    CYKOptions const& options
+):
+    _sourceGrammar(std::make_shared<ContextFreeGrammar const>(sourceGrammar)),
+    _grammar(std::make_shared<ContextFreeGrammar const>(normalizedGrammar)),
+    _options(options)
+{
+    compileRules();
+}
+
+CYK CYK::load(std::string const& path, CYKOptions const& options) {
+    CompiledGrammarReader reader(path);
+    return CYK(reader, options);
+}
+
+CYK CYK::loadOrCompile(
+    ContextFreeGrammar const& grammar,
+    std::string const& path,
+    CYKOptions const& options
+) {
+    try {
+        CompiledGrammarReader reader(path);
+        if (reader.header().sourceHash == grammarHash(grammar)) {
+            return CYK(reader, options);
+        }
+    } catch (CompiledGrammarException const&) {}
+
+    CYK cyk(grammar, options);
+    try {
+        cyk.save(path);
+    } catch (CompiledGrammarException const&) {}
+    return cyk;
+}
+
+void CYK::save(std::string const& path) const {
+    CompiledGrammarWriter writer;
+    writer.write(*_sourceGrammar);
+    writer.write(*_grammar);
+    writer.write(_nonterminals);
+    writer.write(static_cast<std::uint64_t>(_cellSize));
+    writer.write(static_cast<std::uint64_t>(_startIndex));
+    writer.write(static_cast<std::uint64_t>(_acceptsEmptyWord));
+
+    std::vector<std::pair<Symbol, std::vector<std::uint64_t>>> terminalCells(
+        _terminalCells.begin(),
+        _terminalCells.end()
+    );
+    std::sort(terminalCells.begin(), terminalCells.end(), [](auto const& lhs, auto const& rhs) {
+        return lhs.first.rawValue < rhs.first.rawValue;
+    });
+    writer.write(static_cast<std::uint64_t>(terminalCells.size()));
+    for (auto const& [terminal, values]: terminalCells) {
+        writer.write(terminal);
+        for (auto value: values) {
+            writer.write(value);
+        }
+    }
+
+    writer.write(static_cast<std::uint64_t>(_rulesByLeftChild.size()));
+    for (auto index: _rulesByLeftChild) {
+        writer.write(static_cast<std::uint64_t>(index));
+    }
+    writer.write(static_cast<std::uint64_t>(_binaryRules.size()));
+    for (auto [rightChild, parent]: _binaryRules) {
+        writer.write(static_cast<std::uint64_t>(rightChild));
+        writer.write(static_cast<std::uint64_t>(parent));
+    }
+
+    writer.save(path, grammarHash(*_sourceGrammar));
+}
+
+CYK CYK::withOptions(CYKOptions const& options) const {
+    auto cyk = *this;
+    cyk._options = options;
+    return cyk;
+}
+
+ContextFreeGrammar const& CYK::sourceGrammar() const {
+    return *_sourceGrammar;
+}
+
 ContextFreeGrammar const& CYK::grammar() const {
-    return _grammar;
+    return *_grammar;
 }
 
-bool CYK::predict(std::string const& word) const {
+CYKOptions const& CYK::options() const {
+    return _options;
+}
+
+bool CYK::predict(SymbolSequence const& word) const {
+    thread_local Workspace workspace;
+    return predict(word, workspace);
+}
+
+bool CYK::predict(SymbolSequence const& word, Workspace& workspace) const {
     if (word.empty()) {
         return acceptsEmptyWord();
     }
 
-    auto generatesSubword = calculateTableValues(word);
-    return generatesSubword[_grammar.startSymbol()][0][word.size() - 1];
+    auto table = calculateTableValues(word, workspace);
+    return table.contains(_startIndex, 0, word.size() - 1);
+}
+
+PredictionResult CYK::predict(SymbolSequence const& word, PredictionLimits const& limits) const {
+    thread_local Workspace workspace;
+    return predict(word, limits, workspace);
+}
+
+PredictionResult CYK::predict(
+    SymbolSequence const& word,
+    PredictionLimits const& limits,
+    Workspace& workspace
+) const {
+    Monitor monitor(limits, word.size() * (word.size() + 1) / 2);
+    if (!monitor.proceed(0)) {
+        return PredictionResult::Interrupted;
+    }
+    if (word.empty()) {
+        return acceptsEmptyWord() ? PredictionResult::Accepted : PredictionResult::Rejected;
+    }
+
+    auto table = calculateTableValues(word, workspace, &monitor);
+    if (monitor.isInterrupted()) {
+        return PredictionResult::Interrupted;
+    }
+    if (table.contains(_startIndex, 0, word.size() - 1)) {
+        return PredictionResult::Accepted;
+    }
+    return PredictionResult::Rejected;
+}
+
+ParseForest CYK::parse(SymbolSequence const& word) const {
+    thread_local Workspace workspace;
+    return parse(word, workspace);
+}
+
+ParseForest CYK::parse(SymbolSequence const& word, Workspace& workspace) const {
+    ParseForest forest(_sourceGrammar, _grammar);
+    std::vector<std::vector<size_t>> rulesByParent(_nonterminals.size());
+    for (size_t i = 0; i < _grammar->rules().size(); ++i) {
+        rulesByParent[_nonterminalIndices.at(_grammar->rules()[i].lhs[0])].push_back(i);
+    }
+
+    if (word.empty()) {
+        for (auto rule: rulesByParent[_startIndex]) {
+            if (_grammar->rules()[rule].rhs.empty()) {
+                forest._root = forest.addNode(
+                    _grammar->startSymbol(),
+                    0,
+                    0,
+                    {{rule, ParseForest::noNode, ParseForest::noNode}}
+                );
+            }
+        }
+        return forest;
+    }
+
+    auto table = calculateTableValues(word, workspace);
+    if (table.contains(_startIndex, 0, word.size() - 1)) {
+        std::unordered_map<size_t, size_t> forestNodes;
+        forest._root = addForestNode(
+            forest,
+            table,
+            word,
+            rulesByParent,
+            forestNodes,
+            _startIndex,
+            0,
+            word.size() - 1
+        );
+    }
+    return forest;
+}
+
+Chart CYK::chart(SymbolSequence const& word) const {
+    return Chart(*this, word);
 }
 
 bool CYK::acceptsEmptyWord() const {
-    for (auto const& [lhs, rhs]: _grammar.rules()) {
-        if (lhs[0] == _grammar.startSymbol() && rhs.empty()) {
-            return true;
+    return _acceptsEmptyWord;
+}
+
+void CYK::compileRules() {
+    _nonterminals.assign(_grammar->nonterminals().begin(), _grammar->nonterminals().end());
+    std::sort(_nonterminals.begin(), _nonterminals.end(), [](Symbol lhs, Symbol rhs) {
+        return lhs.rawValue < rhs.rawValue;
+    });
+    for (size_t i = 0; i < _nonterminals.size(); ++i) {
+        _nonterminalIndices[_nonterminals[i]] = i;
+    }
+    _cellSize = (_nonterminals.size() + bitsPerCellWord - 1) / bitsPerCellWord;
+    _startIndex = _nonterminalIndices.at(_grammar->startSymbol());
+
+    _acceptsEmptyWord = false;
+    std::vector<std::vector<BinaryRule>> rulesByLeftChild(_nonterminals.size());
+    for (auto const& [lhs, rhs]: _grammar->rules()) {
+        auto parent = _nonterminalIndices.at(lhs[0]);
+        if (rhs.empty()) {
+            _acceptsEmptyWord |= parent == _startIndex;
+        } else if (rhs.size() == 1 && _grammar->symbolIsTerminal(rhs[0])) {
+            auto& values = _terminalCells[rhs[0]];
+            values.resize(_cellSize);
+            insertBit(values.data(), parent);
+        } else if (rhs.size() == 2) {
+            rulesByLeftChild[_nonterminalIndices.at(rhs[0])].push_back({
+                _nonterminalIndices.at(rhs[1]),
+                parent
+            });
         }
     }
-    return false;
+
+    _rulesByLeftChild.assign(1, 0);
+    for (auto const& rules: rulesByLeftChild) {
+        _binaryRules.insert(_binaryRules.end(), rules.begin(), rules.end());
+        _rulesByLeftChild.push_back(_binaryRules.size());
+    }
 }
 
-void CYK::findDirectChildren(
-    std::unordered_map<Symbol, Alphabet>& terminalChildren,
-    std::unordered_map<Symbol, std::vector<Word>>& nonterminalChildren
+bool CYK::generatesSubword(
+    Table const& table,
+    Symbol nonterminal,
+    size_t subwordStart,
+    size_t subwordEnd
 ) const {
-    for (auto nonterminal: _grammar.nonterminals()) {
-        terminalChildren[nonterminal] = {};
-        nonterminalChildren[nonterminal] = {};
+    auto index = _nonterminalIndices.find(nonterminal);
+    if (index == _nonterminalIndices.end()) {
+        return false;
     }
+    return table.contains(index->second, subwordStart, subwordEnd);
+}
 
-    for (auto const& [lhs, rhs]: _grammar.rules()) {
-        if (rhs.size() == 1 && _grammar.symbolIsTerminal(rhs[0])) {
-            terminalChildren[lhs[0]].insert(rhs[0]);
-        } else if (rhs.size() == 2) {
-            nonterminalChildren[lhs[0]].emplace_back(rhs);
+size_t CYK::tileSize(size_t wordSize) const {
+    if (_options.tileSize) {
+        return std::max<size_t>(std::min(_options.tileSize, wordSize), 1);
+    }
+
+    size_t tileSize = minTileSize;
+    while ((2 * tileSize) * (2 * tileSize) * _cellSize * sizeof(std::uint64_t) <= tileBytes) {
+        tileSize *= 2;
+    }
+    return std::max<size_t>(std::min(tileSize, wordSize), 1);
+}
+
+size_t CYK::layoutTable(size_t wordSize, ChartLayout layout, Workspace& workspace) const {
+    auto rowOffsets = workspace.reserve(workspace._rowOffsets, wordSize);
+    auto columnOffsets = workspace.reserve(workspace._columnOffsets, wordSize);
+    if (layout == ChartLayout::Square) {
+        for (size_t i = 0; i < wordSize; ++i) {
+            rowOffsets[i] = i * wordSize;
+            columnOffsets[i] = i;
+        }
+        return wordSize * wordSize;
+    }
+
+    std::ptrdiff_t rowCount = wordSize;
+    std::ptrdiff_t tileSize = this->tileSize(wordSize);
+    std::ptrdiff_t tileArea = tileSize * tileSize;
+    std::ptrdiff_t tileCount = (rowCount + tileSize - 1) / tileSize;
+    std::ptrdiff_t tileRowStart = 0;
+    for (std::ptrdiff_t tileRow = tileCount - 1; tileRow >= 0; --tileRow) {
+        std::ptrdiff_t rowEnd = std::min(rowCount, (tileRow + 1) * tileSize);
+        for (std::ptrdiff_t i = tileRow * tileSize; i < rowEnd; ++i) {
+            rowOffsets[i] = (tileRowStart - tileRow) * tileArea + (i % tileSize) * tileSize;
+        }
+        tileRowStart += tileCount - tileRow;
+    }
+    for (std::ptrdiff_t i = 0; i < rowCount; ++i) {
+        columnOffsets[i] = (i / tileSize) * tileArea + i % tileSize;
+    }
+    return tileRowStart * tileArea;
+}
+
+CYK::Table CYK::initTable(SymbolSequence const& word, Workspace& workspace) const {
+    size_t tableSize = layoutTable(word.size(), _options.layout, workspace) * _cellSize;
+    bool isOutOfCore = (
+        _options.maxInMemoryChartSize &&
+        tableSize * sizeof(std::uint64_t) > _options.maxInMemoryChartSize
+    );
+    if (isOutOfCore && _options.layout != ChartLayout::TriangularTiled) {
+        tableSize = layoutTable(word.size(), ChartLayout::TriangularTiled, workspace) * _cellSize;
+    }
+
+    std::uint64_t* cells;
+    if (isOutOfCore) {
+        cells = workspace.reserveScratchFile(_options.scratchDirectory, tableSize);
+    } else {
+        cells = workspace.reserve(workspace._cells, tableSize);
+        std::fill(cells, cells + tableSize, 0);
+    }
+
+    Table table(
+        cells,
+        workspace._rowOffsets.data(),
+        workspace._columnOffsets.data(),
+        word.size(),
+        _cellSize,
+        isOutOfCore ? &workspace._scratchCells : nullptr,
+        &workspace._counters
+    );
+    if constexpr (instrumentationEnabled) {
+        workspace._counters.peakChartBytes = tableSize * sizeof(std::uint64_t);
+    }
+    for (size_t i = 0; i < word.size(); ++i) {
+        auto values = _terminalCells.find(word[i]);
+        if (values != _terminalCells.end()) {
+            std::copy(values->second.begin(), values->second.end(), table.cell(i, i));
         }
     }
+
+    return table;
 }
 
-CYK::Table CYK::initTable(
-    std::string const& word,
-    std::unordered_map<Symbol, Alphabet> const& terminalChildren
+void CYK::calculateSubwordValues(Table& table, size_t subwordStart, size_t subwordSize) const {
+    size_t subwordEnd = subwordStart + subwordSize - 1;
+    auto values = table.cell(subwordStart, subwordEnd);
+    auto counters = instrumentationEnabled ? table.counters() : nullptr;
+    for (size_t i = subwordStart; i < subwordEnd; ++i) {
+        combineCells(table.cell(subwordStart, i), table.cell(i + 1, subwordEnd), values, counters);
+    }
+    if constexpr (instrumentationEnabled) {
+        countSubwordValues(table, subwordStart, subwordEnd);
+    }
+}
+
+void CYK::countSubwordValues(Table const& table, size_t subwordStart, size_t subwordEnd) const {
+    auto& counters = *table.counters();
+    ++counters.computedCellCount;
+    auto values = table.cell(subwordStart, subwordEnd);
+    for (size_t j = 0; j < _cellSize; ++j) {
+        counters.derivedSymbolCount += __builtin_popcountll(values[j]);
+    }
+}
+
+void CYK::combineCells(
+    std::uint64_t const* leftValues,
+    std::uint64_t const* rightValues,
+    std::uint64_t* values,
+    CYKCounters* counters
 ) const {
-    Table generatesSubword;
-    for (auto nonterminal: _grammar.nonterminals()) {
-        generatesSubword[nonterminal] = std::vector<std::vector<bool>>(
-            word.size(),
-            std::vector<bool>(word.size())
-        );
-        for (size_t i = 0; i < word.size(); ++i) {
-            generatesSubword[nonterminal][i][i] = terminalChildren.at(nonterminal).count(word[i]);
+    for (size_t i = 0; i < _cellSize; ++i) {
+        for (auto bits = leftValues[i]; bits; bits &= bits - 1) {
+            size_t leftChild = i * bitsPerCellWord + __builtin_ctzll(bits);
+            if constexpr (instrumentationEnabled) {
+                if (counters) {
+                    counters->ruleCheckCount += (
+                        _rulesByLeftChild[leftChild + 1] - _rulesByLeftChild[leftChild]
+                    );
+                }
+            }
+            for (
+                size_t j = _rulesByLeftChild[leftChild];
+                j < _rulesByLeftChild[leftChild + 1];
+                ++j
+            ) {
+                auto [rightChild, parent] = _binaryRules[j];
+                if (containsBit(rightValues, rightChild)) {
+                    insertBit(values, parent);
+                }
+            }
         }
     }
+}
 
-    return generatesSubword;
+void CYK::calculatePrefixHashes(SymbolSequence const& word, Workspace& workspace) const {
+    auto prefixHashes = workspace.reserve(workspace._prefixHashes, word.size() + 1);
+    prefixHashes[0] = 0;
+    for (size_t i = 0; i < word.size(); ++i) {
+        auto symbolHash = static_cast<std::uint32_t>(word[i].rawValue) + std::uint64_t(1);
+        prefixHashes[i + 1] = prefixHashes[i] * hashBase + symbolHash;
+    }
 }
 
-void CYK::checkIfNonterminalGeneratesSubword(
-    Symbol nonterminal,
-    std::unordered_map<Symbol, std::vector<Word>> const& nonterminalChildren,
-    Table& generatesSubword,
-    size_t subwordStart,
+size_t const* CYK::findEqualSubwords(
+    SymbolSequence const& word,
+    Workspace& workspace,
     size_t subwordSize
 ) const {
-    bool canGenerate = false;
-    for (auto const& rhs: nonterminalChildren.at(nonterminal)) {
-        for (size_t i = subwordStart; i + 1 < subwordStart + subwordSize; ++i) {
-            canGenerate |= (
-                generatesSubword[rhs[0]][subwordStart][i] &&
-                generatesSubword[rhs[1]][i + 1][subwordStart + subwordSize - 1]
-            );
+    std::uint64_t power = 1;
+    for (size_t i = 0; i < subwordSize; ++i) {
+        power *= hashBase;
+    }
+
+    size_t subwordCount = word.size() - subwordSize + 1;
+    size_t slotMask = 1;
+    while (slotMask < 2 * subwordCount) {
+        slotMask *= 2;
+    }
+    size_t slotCount = slotMask--;
+
+    auto prefixHashes = workspace._prefixHashes.data();
+    auto equalSubwords = workspace.reserve(workspace._equalSubwords, subwordCount);
+    auto hashSlots = workspace.reserve(workspace._hashSlots, slotCount);
+    std::fill(hashSlots, hashSlots + slotCount, 0);
+
+    for (size_t subwordStart = 0; subwordStart < subwordCount; ++subwordStart) {
+        auto hash = subwordHash(prefixHashes, power, subwordStart, subwordSize);
+        equalSubwords[subwordStart] = subwordStart;
+        for (size_t slot = ((hash * hashMixer) >> 32) & slotMask;; slot = (slot + 1) & slotMask) {
+            if (!hashSlots[slot]) {
+                hashSlots[slot] = subwordStart + 1;
+                break;
+            }
+            size_t occurrence = hashSlots[slot] - 1;
+            if (
+                subwordHash(prefixHashes, power, occurrence, subwordSize) == hash &&
+                word.subwordsAreEqual(occurrence, subwordStart, subwordSize)
+            ) {
+                equalSubwords[subwordStart] = occurrence;
+                break;
+            }
         }
     }
-    generatesSubword[nonterminal][subwordStart][subwordStart + subwordSize - 1] = canGenerate;
+
+    return equalSubwords;
+}
+
+void CYK::copySubwordValues(
+    Table& table,
+    size_t sourceStart,
+    size_t subwordStart,
+    size_t subwordSize
+) const {
+    auto values = table.cell(sourceStart, sourceStart + subwordSize - 1);
+    std::copy(values, values + _cellSize, table.cell(subwordStart, subwordStart + subwordSize - 1));
 }
 
-CYK::Table CYK::calculateTableValues(std::string const& word) const {
-    std::unordered_map<Symbol, Alphabet> terminalChildren;
-    std::unordered_map<Symbol, std::vector<Word>> nonterminalChildren;
-    findDirectChildren(terminalChildren, nonterminalChildren);
-    auto generatesSubword = initTable(word, terminalChildren);
+void CYK::calculateTableValuesByDiagonals(
+    SymbolSequence const& word,
+    Workspace& workspace,
+    Table& table,
+    Monitor* monitor
+) const {
+    if (_options.memoizeRepeatedSubwords) {
+        calculatePrefixHashes(word, workspace);
+    }
 
     for (size_t subwordSize = 2; subwordSize <= word.size(); ++subwordSize) {
+        size_t const* equalSubwords = nullptr;
+        if (_options.memoizeRepeatedSubwords) {
+            equalSubwords = findEqualSubwords(word, workspace, subwordSize);
+        }
+
         for (size_t subwordStart = 0; subwordStart + subwordSize <= word.size(); ++subwordStart) {
-            for (auto nonterminal: _grammar.nonterminals()) {
-                checkIfNonterminalGeneratesSubword(
-                    nonterminal,
-                    nonterminalChildren,
-                    generatesSubword,
+            if (
+                monitor &&
+                subwordStart % cellsPerInterruptionCheck == cellsPerInterruptionCheck - 1 &&
+                !monitor->proceed(cellsPerInterruptionCheck)
+            ) {
+                return;
+            }
+
+            if (equalSubwords && equalSubwords[subwordStart] != subwordStart) {
+                copySubwordValues(
+                    table,
+                    equalSubwords[subwordStart],
                     subwordStart,
                     subwordSize
                 );
+                continue;
             }
+
+            calculateSubwordValues(table, subwordStart, subwordSize);
+        }
+
+        size_t cellCount = word.size() - subwordSize + 1;
+        if (monitor && !monitor->proceed(cellCount % cellsPerInterruptionCheck)) {
+            return;
         }
     }
+}
+
+void CYK::calculateTableValuesByTiles(Table& table, Monitor* monitor) const {
+    size_t wordSize = table.wordSize();
+    size_t tileSize = this->tileSize(wordSize);
+    size_t tileCount = (wordSize + tileSize - 1) / tileSize;
+    for (size_t tileRow = tileCount; tileRow-- > 0;) {
+        size_t rowEnd = std::min(wordSize, (tileRow + 1) * tileSize);
+        for (size_t tileColumn = tileRow; tileColumn < tileCount; ++tileColumn) {
+            size_t columnEnd = std::min(wordSize, (tileColumn + 1) * tileSize);
+            for (size_t i = tileRow + 1; i <= tileColumn; ++i) {
+                table.prefetch(i * tileSize, tileColumn * tileSize, tileSize * tileSize);
+            }
+
+            size_t cellCount = 0;
+            for (size_t subwordStart = rowEnd; subwordStart-- > tileRow * tileSize;) {
+                size_t columnStart = std::max(subwordStart + 1, tileColumn * tileSize);
+                for (size_t subwordEnd = columnStart; subwordEnd < columnEnd; ++subwordEnd) {
+                    calculateSubwordValues(table, subwordStart, subwordEnd - subwordStart + 1);
+                    ++cellCount;
+                }
+            }
+
+            if (monitor && !monitor->proceed(cellCount)) {
+                return;
+            }
+        }
+    }
+}
+
+void CYK::fillTable(
+    SymbolSequence const& word,
+    Workspace& workspace,
+    Table& table,
+    Monitor* monitor
+) const {
+    if (monitor && !monitor->proceed(word.size())) {
+        return;
+    }
+
+    if (
+        table.isOutOfCore() ||
+        (_options.layout == ChartLayout::TriangularTiled && !_options.memoizeRepeatedSubwords)
+    ) {
+        calculateTableValuesByTiles(table, monitor);
+    } else {
+        calculateTableValuesByDiagonals(word, workspace, table, monitor);
+    }
+}
+
+CYK::Table CYK::calculateCountedTableValues(
+    SymbolSequence const& word,
+    Workspace& workspace,
+    Monitor* monitor
+) const {
+    using Clock = std::chrono::steady_clock;
+    auto nanoseconds = [](Clock::duration duration) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+    };
+    auto& counters = workspace._counters;
+    counters.clear();
+    counters.chartCount = 1;
+    auto capacity = workspace.capacity();
+
+    auto startTime = Clock::now();
+    auto table = initTable(word, workspace);
+    auto initEndTime = Clock::now();
+    fillTable(word, workspace, table, monitor);
+
+    counters.initNanoseconds = nanoseconds(initEndTime - startTime);
+    counters.fillNanoseconds = nanoseconds(Clock::now() - initEndTime);
+    counters.allocatedBytes = workspace.capacity() - capacity;
+    CYKCounters::record(counters);
+    return table;
+}
+
+CYK::Table CYK::calculateTableValues(
+    SymbolSequence const& word,
+    Workspace& workspace,
+    Monitor* monitor
+) const {
+    if constexpr (instrumentationEnabled) {
+        return calculateCountedTableValues(word, workspace, monitor);
+    } else {
+        auto table = initTable(word, workspace);
+        fillTable(word, workspace, table, monitor);
+        return table;
+    }
+}
+
+size_t CYK::addForestNode(
+    ParseForest& forest,
+    Table const& table,
+    SymbolSequence const& word,
+    std::vector<std::vector<size_t>> const& rulesByParent,
+    std::unordered_map<size_t, size_t>& forestNodes,
+    size_t nonterminal,
+    size_t subwordStart,
+    size_t subwordEnd
+) const {
+    size_t key = (nonterminal * word.size() + subwordStart) * word.size() + subwordEnd;
+    auto forestNode = forestNodes.find(key);
+    if (forestNode != forestNodes.end()) {
+        return forestNode->second;
+    }
+
+    std::vector<ParseForest::Alternative> alternatives;
+    for (auto rule: rulesByParent[nonterminal]) {
+        auto const& rhs = _grammar->rules()[rule].rhs;
+        if (rhs.size() == 1) {
+            if (subwordStart == subwordEnd && rhs[0] == word[subwordStart]) {
+                alternatives.push_back({rule, ParseForest::noNode, ParseForest::noNode});
+            }
+            continue;
+        }
+        if (rhs.size() != 2) {
+            continue;
+        }
+        auto leftChild = _nonterminalIndices.at(rhs[0]);
+        auto rightChild = _nonterminalIndices.at(rhs[1]);
+        for (size_t i = subwordStart; i < subwordEnd; ++i) {
+            if (
+                !table.contains(leftChild, subwordStart, i) ||
+                !table.contains(rightChild, i + 1, subwordEnd)
+            ) {
+                continue;
+            }
+            auto left = addForestNode(
+                forest, table, word, rulesByParent, forestNodes, leftChild, subwordStart, i
+            );
+            auto right = addForestNode(
+                forest, table, word, rulesByParent, forestNodes, rightChild, i + 1, subwordEnd
+            );
+            alternatives.push_back({rule, left, right});
+        }
+    }
+
+    auto node = forest.addNode(
+        _nonterminals[nonterminal],
+        subwordStart,
+        subwordEnd - subwordStart + 1,
+        alternatives
+    );
+    forestNodes.emplace(key, node);
+    return node;
+}
+
+Chart::Chart(CYK const& cyk, SymbolSequence const& word):
+    _nonterminalIndices(cyk._nonterminalIndices),
+    _startSymbol(cyk._grammar->startSymbol()),
+    _startIndex(cyk._startIndex),
+    _acceptsEmptyWord(cyk._acceptsEmptyWord),
+    _workspace(std::make_unique<CYK::Workspace>()),
+    _table(cyk.calculateTableValues(word, *_workspace))
+{}
+
+size_t Chart::wordSize() const {
+    return _table.wordSize();
+}
+
+bool Chart::accepted() const {
+    if (!wordSize()) {
+        return _acceptsEmptyWord;
+    }
+    return accepts(0, wordSize() - 1);
+}
+
+bool Chart::derives(Symbol nonterminal, size_t subwordStart, size_t subwordEnd) const {
+    auto index = _nonterminalIndices.find(nonterminal);
+    if (index == _nonterminalIndices.end() || !isSubword(subwordStart, subwordEnd)) {
+        return false;
+    }
+    return _table.contains(index->second, subwordStart, subwordEnd);
+}
+
+bool Chart::accepts(size_t subwordStart, size_t subwordEnd) const {
+    return isSubword(subwordStart, subwordEnd) &&
+        _table.contains(_startIndex, subwordStart, subwordEnd);
+}
+
+bool Chart::isSubword(size_t subwordStart, size_t subwordEnd) const {
+    return subwordStart <= subwordEnd && subwordEnd < wordSize();
+}
+
+std::vector<Chart::Span> Chart::spansAcceptedBy(Symbol nonterminal) const {
+    std::vector<Span> spans;
+    forEachSpan(nonterminal, [&spans](Span span) {
+        spans.push_back(span);
+    });
+    return spans;
+}
 
-    return generatesSubword;
+std::vector<Chart::Span> Chart::acceptedSpans() const {
+    return spansAcceptedBy(_startSymbol);
 }
 
 }
@@ -1,40 +1,308 @@
 #pragma once
 
 #include "ContextFreeGrammar.hpp"
+#include "CompiledGrammar.hpp"
+#include "CYKCounters.hpp"
+#include "ScratchFile.hpp"
+#include "ParseForest.hpp"
+#include "SymbolSequence.hpp"
 #include <unordered_map>
 #include <string>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
 
 namespace FL {
 
+enum class ChartLayout {
+    Square,
+    TriangularTiled
+};
+
+struct CYKOptions {
+    bool memoizeRepeatedSubwords = false;
+    ChartLayout layout = ChartLayout::Square;
+    size_t tileSize = 0;
+    size_t maxInMemoryChartSize = 0;
+    std::string scratchDirectory;
+};
+
+enum class PredictionResult {
+    Accepted,
+    Rejected,
+    Interrupted
+};
+
+class CancellationToken {
+public:
+    void cancel();
+    bool isCancelled() const;
+
+protected:
+    std::atomic<bool> _isCancelled{false};
+};
+
+struct PredictionLimits {
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+    CancellationToken const* cancellationToken = nullptr;
+    std::function<void(double)> progressHandler;
+};
+
+template<typename Semiring>
+class SemiringCYK;
+
+class Chart;
+
 class CYK {
 public:
-    explicit CYK(ContextFreeGrammar const& grammar);
+    class Workspace {
+    public:
+        size_t allocationCount() const;
+        size_t capacity() const;
+        CYKCounters const& counters() const;
+
+    protected:
+        friend class CYK;
+        template<typename Semiring>
+        friend class SemiringCYK;
+
+        template<typename T>
+        T* reserve(std::vector<T>& buffer, size_t size);
+        std::uint64_t* reserveScratchFile(std::string const& directory, size_t size);
+
+        std::vector<std::uint64_t> _cells;
+        ScratchFile _scratchCells;
+        std::vector<std::ptrdiff_t> _rowOffsets;
+        std::vector<std::ptrdiff_t> _columnOffsets;
+        std::vector<std::uint64_t> _prefixHashes;
+        std::vector<size_t> _equalSubwords;
+        std::vector<size_t> _hashSlots;
+        size_t _allocationCount = 0;
+        CYKCounters _counters;
+    };
 
+    explicit CYK(ContextFreeGrammar const& grammar, CYKOptions const& options = {});
+
+    static CYK load(std::string const& path, CYKOptions const& options = {});
+    static CYK loadOrCompile(
+        ContextFreeGrammar const& grammar,
+        std::string const& path,
+        CYKOptions const& options = {}
+    );
+    void save(std::string const& path) const;
+    CYK withOptions(CYKOptions const& options) const;
+
+    ContextFreeGrammar const& sourceGrammar() const;
     ContextFreeGrammar const& grammar() const;
-    bool predict(std::string const& word) const;
+    CYKOptions const& options() const;
+    bool predict(SymbolSequence const& word) const;
+    bool predict(SymbolSequence const& word, Workspace& workspace) const;
+    PredictionResult predict(SymbolSequence const& word, PredictionLimits const& limits) const;
+    PredictionResult predict(
+        SymbolSequence const& word,
+        PredictionLimits const& limits,
+        Workspace& workspace
+    ) const;
+    ParseForest parse(SymbolSequence const& word) const;
+    ParseForest parse(SymbolSequence const& word, Workspace& workspace) const;
+    Chart chart(SymbolSequence const& word) const;
 
 protected:
-    using Table = std::unordered_map<Symbol, std::vector<std::vector<bool>>>;
+    friend class Chart;
+
+    CYK(CompiledGrammarReader& reader, CYKOptions const& options);
+    CYK(
+        ContextFreeGrammar const& sourceGrammar,
+        ContextFreeGrammar const& normalizedGrammar,
+        CYKOptions const& options
+    );
+
+    class Monitor {
+    public:
+        Monitor(PredictionLimits const& limits, size_t cellCount);
+
+        bool isInterrupted() const;
+        bool proceed(size_t computedCellCount);
+
+    protected:
+        PredictionLimits const& _limits;
+        size_t _cellCount;
+        size_t _computedCellCount;
+        size_t _reportedCellCount;
+        bool _isInterrupted;
+    };
+
+    struct BinaryRule {
+        size_t rightChild;
+        size_t parent;
+    };
+
+    class Table {
+    public:
+        Table(
+            std::uint64_t* cells,
+            std::ptrdiff_t const* rowOffsets,
+            std::ptrdiff_t const* columnOffsets,
+            size_t wordSize,
+            size_t cellSize,
+            ScratchFile const* scratchFile = nullptr,
+            CYKCounters* counters = nullptr
+        );
+
+        size_t wordSize() const;
+        bool isOutOfCore() const;
+        CYKCounters* counters() const;
+        void prefetch(size_t subwordStart, size_t subwordEnd, size_t cellCount) const;
+        std::uint64_t* cell(size_t subwordStart, size_t subwordEnd);
+        std::uint64_t const* cell(size_t subwordStart, size_t subwordEnd) const;
+        bool contains(size_t nonterminal, size_t subwordStart, size_t subwordEnd) const;
+
+    protected:
+        std::uint64_t* _cells;
+        std::ptrdiff_t const* _rowOffsets;
+        std::ptrdiff_t const* _columnOffsets;
+        size_t _wordSize;
+        size_t _cellSize;
+        ScratchFile const* _scratchFile;
+        CYKCounters* _counters;
+    };
 
     bool acceptsEmptyWord() const;
-    void findDirectChildren(
-        std::unordered_map<Symbol, Alphabet>& terminalChildren,
-        std::unordered_map<Symbol, std::vector<Word>>& nonterminalChildren
+    void compileRules();
+    bool generatesSubword(
+        Table const& table,
+        Symbol nonterminal,
+        size_t subwordStart,
+        size_t subwordEnd
     ) const;
-    Table initTable(
-        std::string const& word,
-        std::unordered_map<Symbol, Alphabet> const& terminalChildren
+    size_t tileSize(size_t wordSize) const;
+    size_t layoutTable(size_t wordSize, ChartLayout layout, Workspace& workspace) const;
+    Table initTable(SymbolSequence const& word, Workspace& workspace) const;
+    void calculateSubwordValues(Table& table, size_t subwordStart, size_t subwordSize) const;
+    void countSubwordValues(Table const& table, size_t subwordStart, size_t subwordEnd) const;
+    void combineCells(
+        std::uint64_t const* leftValues,
+        std::uint64_t const* rightValues,
+        std::uint64_t* values,
+        CYKCounters* counters = nullptr
     ) const;
-    void checkIfNonterminalGeneratesSubword(
-        Symbol nonterminal,
-        std::unordered_map<Symbol, std::vector<Word>> const& nonterminalChildren,
-        Table& generatesSubword,
+    void calculatePrefixHashes(SymbolSequence const& word, Workspace& workspace) const;
+    size_t const* findEqualSubwords(
+        SymbolSequence const& word,
+        Workspace& workspace,
+        size_t subwordSize
+    ) const;
+    void copySubwordValues(
+        Table& table,
+        size_t sourceStart,
         size_t subwordStart,
         size_t subwordSize
     ) const;
-    Table calculateTableValues(std::string const& word) const;
+    void calculateTableValuesByDiagonals(
+        SymbolSequence const& word,
+        Workspace& workspace,
+        Table& table,
+        Monitor* monitor
+    ) const;
+    void calculateTableValuesByTiles(Table& table, Monitor* monitor) const;
+    void fillTable(
+        SymbolSequence const& word,
+        Workspace& workspace,
+        Table& table,
+        Monitor* monitor
+    ) const;
+    Table calculateCountedTableValues(
+        SymbolSequence const& word,
+        Workspace& workspace,
+        Monitor* monitor
+    ) const;
+    Table calculateTableValues(
+        SymbolSequence const& word,
+        Workspace& workspace,
+        Monitor* monitor = nullptr
+    ) const;
+    size_t addForestNode(
+        ParseForest& forest,
+        Table const& table,
+        SymbolSequence const& word,
+        std::vector<std::vector<size_t>> const& rulesByParent,
+        std::unordered_map<size_t, size_t>& forestNodes,
+        size_t nonterminal,
+        size_t subwordStart,
+        size_t subwordEnd
+    ) const;
 
-    ContextFreeGrammar _grammar;
+    std::shared_ptr<ContextFreeGrammar const> _sourceGrammar;
+    std::shared_ptr<ContextFreeGrammar const> _grammar;
+    CYKOptions _options;
+    std::vector<Symbol> _nonterminals;
+    std::unordered_map<Symbol, size_t> _nonterminalIndices;
+    std::unordered_map<Symbol, std::vector<std::uint64_t>> _terminalCells;
+    std::vector<size_t> _rulesByLeftChild;
+    std::vector<BinaryRule> _binaryRules;
+    size_t _cellSize;
+    size_t _startIndex;
+    bool _acceptsEmptyWord;
 };
 
+class Chart {
+public:
+    struct Span {
+        size_t start;
+        size_t size;
+    };
+
+    size_t wordSize() const;
+    bool accepted() const;
+    bool derives(Symbol nonterminal, size_t subwordStart, size_t subwordEnd) const;
+    bool accepts(size_t subwordStart, size_t subwordEnd) const;
+    std::vector<Span> spansAcceptedBy(Symbol nonterminal) const;
+    std::vector<Span> acceptedSpans() const;
+
+    template<typename Callback>
+    void forEachSpan(Symbol nonterminal, Callback&& callback) const;
+
+protected:
+    friend class CYK;
+
+    Chart(CYK const& cyk, SymbolSequence const& word);
+
+    bool isSubword(size_t subwordStart, size_t subwordEnd) const;
+
+    std::unordered_map<Symbol, size_t> _nonterminalIndices;
+    Symbol _startSymbol;
+    size_t _startIndex;
+    bool _acceptsEmptyWord;
+    std::unique_ptr<CYK::Workspace> _workspace;
+    CYK::Table _table;
+};
+
+template<typename T>
+T* CYK::Workspace::reserve(std::vector<T>& buffer, size_t size) {
+    if (buffer.size() < size) {
+        ++_allocationCount;
+        buffer.resize(size);
+    }
+    return buffer.data();
+}
+
+template<typename Callback>
+void Chart::forEachSpan(Symbol nonterminal, Callback&& callback) const {
+    auto index = _nonterminalIndices.find(nonterminal);
+    if (index == _nonterminalIndices.end()) {
+        return;
+    }
+    for (size_t subwordStart = 0; subwordStart < _table.wordSize(); ++subwordStart) {
+        for (size_t subwordEnd = subwordStart; subwordEnd < _table.wordSize(); ++subwordEnd) {
+            if (_table.contains(index->second, subwordStart, subwordEnd)) {
+                callback(Span{subwordStart, subwordEnd - subwordStart + 1});
+            }
+        }
+    }
+}
+
 }
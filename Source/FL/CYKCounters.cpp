@@ -0,0 +1,164 @@
+#include "CYKCounters.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+namespace FL {
+
+namespace {
+
+class ThreadCounters;
+
+class CounterRegistry {
+public:
+    void add(ThreadCounters* counters);
+    void remove(ThreadCounters* counters);
+    CYKCounters snapshot();
+    void reset();
+
+protected:
+    std::mutex _mutex;
+    std::vector<ThreadCounters*> _threads;
+    CYKCounters _finishedThreads;
+};
+
+class ThreadCounters {
+public:
+    ThreadCounters();
+    ~ThreadCounters();
+
+    ThreadCounters(ThreadCounters const&) = delete;
+    ThreadCounters& operator=(ThreadCounters const&) = delete;
+
+    void record(CYKCounters const& counters);
+    void mergeInto(CYKCounters& counters);
+    void clear();
+
+protected:
+    std::mutex _mutex;
+    CYKCounters _counters;
+};
+
+CounterRegistry& registry() {
+    static CounterRegistry registry;
+    return registry;
+}
+
+ThreadCounters& threadCounters() {
+    thread_local ThreadCounters counters;
+    return counters;
+}
+
+std::pair<char const*, std::uint64_t CYKCounters::*> const fields[] = {
+    {"chartCount", &CYKCounters::chartCount},
+    {"computedCellCount", &CYKCounters::computedCellCount},
+    {"ruleCheckCount", &CYKCounters::ruleCheckCount},
+    {"derivedSymbolCount", &CYKCounters::derivedSymbolCount},
+    {"initNanoseconds", &CYKCounters::initNanoseconds},
+    {"fillNanoseconds", &CYKCounters::fillNanoseconds},
+    {"allocatedBytes", &CYKCounters::allocatedBytes},
+    {"peakChartBytes", &CYKCounters::peakChartBytes}
+};
+
+void CounterRegistry::add(ThreadCounters* counters) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _threads.push_back(counters);
+}
+
+void CounterRegistry::remove(ThreadCounters* counters) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    counters->mergeInto(_finishedThreads);
+    _threads.erase(std::find(_threads.begin(), _threads.end(), counters));
+}
+
+CYKCounters CounterRegistry::snapshot() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto counters = _finishedThreads;
+    for (auto thread: _threads) {
+        thread->mergeInto(counters);
+    }
+    return counters;
+}
+
+void CounterRegistry::reset() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _finishedThreads.clear();
+    for (auto thread: _threads) {
+        thread->clear();
+    }
+}
+
+ThreadCounters::ThreadCounters() {
+    registry().add(this);
+}
+
+ThreadCounters::~ThreadCounters() {
+    registry().remove(this);
+}
+
+void ThreadCounters::record(CYKCounters const& counters) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _counters.merge(counters);
+}
+
+void ThreadCounters::mergeInto(CYKCounters& counters) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    counters.merge(_counters);
+}
+
+void ThreadCounters::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _counters.clear();
+}
+
+}
+
+CYKCounters CYKCounters::snapshot() {
+    return registry().snapshot();
+}
+
+void CYKCounters::record(CYKCounters const& counters) {
+    threadCounters().record(counters);
+}
+
+void CYKCounters::reset() {
+    registry().reset();
+}
+
+void CYKCounters::merge(CYKCounters const& counters) {
+    for (auto [name, field]: fields) {
+        if (field != &CYKCounters::peakChartBytes) {
+            this->*field += counters.*field;
+        }
+    }
+    peakChartBytes = std::max(peakChartBytes, counters.peakChartBytes);
+}
+
+void CYKCounters::clear() {
+    *this = CYKCounters();
+}
+
+std::string CYKCounters::toText() const {
+    std::ostringstream text;
+    for (auto [name, field]: fields) {
+        text << name << ": " << this->*field << '\n';
+    }
+    return text.str();
+}
+
+std::string CYKCounters::toJSON() const {
+    std::ostringstream json;
+    char const* separator = "";
+    json << '{';
+    for (auto [name, field]: fields) {
+        json << separator << '"' << name << "\": " << this->*field;
+        separator = ", ";
+    }
+    json << '}';
+    return json.str();
+}
+
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace FL {
+
+#ifdef FL_INSTRUMENTATION
+constexpr bool instrumentationEnabled = true;
+#else
+constexpr bool instrumentationEnabled = false;
+#endif
+
+struct CYKCounters {
+    std::uint64_t chartCount = 0;
+    std::uint64_t computedCellCount = 0;
+    std::uint64_t ruleCheckCount = 0;
+    std::uint64_t derivedSymbolCount = 0;
+    std::uint64_t initNanoseconds = 0;
+    std::uint64_t fillNanoseconds = 0;
+    std::uint64_t allocatedBytes = 0;
+    std::uint64_t peakChartBytes = 0;
+
+    static CYKCounters snapshot();
+    static void record(CYKCounters const& counters);
+    static void reset();
+
+    void merge(CYKCounters const& counters);
+    void clear();
+
+    std::string toText() const;
+    std::string toJSON() const;
+};
+
+}
@@ -0,0 +1,300 @@
+#include "CodeGenerator.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <sstream>
+#include <unordered_map>
+
+namespace FL {
+
+namespace {
+
+constexpr size_t byteCount = 256;
+
+char const* const recognizerSource = R"(
+std::size_t lowestBit(Word bits) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<std::size_t>(__builtin_ctzll(bits));
+#else
+    constexpr std::size_t positions[] = {
+        0, 1, 48, 2, 57, 49, 28, 3, 61, 58, 50, 42, 38, 29, 17, 4,
+        62, 55, 59, 36, 53, 51, 43, 22, 45, 39, 33, 30, 24, 18, 12, 5,
+        63, 47, 56, 27, 60, 41, 37, 16, 54, 35, 52, 21, 44, 32, 23, 11,
+        46, 26, 40, 15, 34, 20, 31, 10, 25, 14, 19, 9, 13, 8, 7, 6
+    };
+    auto value = static_cast<std::uint64_t>(bits);
+    return positions[((value & (~value + 1)) * 0x03f79d71b4cb0a89u) >> 58];
+#endif
+}
+
+bool contains(Cell const& cell, std::size_t index) {
+    return (cell.words[index / wordBits] >> (index % wordBits)) & 1;
+}
+
+void insert(Cell& cell, std::size_t index) {
+    cell.words[index / wordBits] |= static_cast<Word>(Word(1) << (index % wordBits));
+}
+
+}
+
+bool recognize(char const* word, std::size_t size) {
+    if (size == 0) {
+        return acceptsEmptyWord;
+    }
+
+    thread_local std::vector<Cell> table;
+    table.assign(size * size, Cell{});
+    for (std::size_t i = 0; i < size; ++i) {
+        if (!initCell(static_cast<unsigned char>(word[i]), table[i])) {
+            return false;
+        }
+    }
+
+    for (std::size_t subwordSize = 2; subwordSize <= size; ++subwordSize) {
+        for (std::size_t start = 0; start + subwordSize <= size; ++start) {
+            Cell& cell = table[(subwordSize - 1) * size + start];
+            for (std::size_t leftSize = 1; leftSize < subwordSize; ++leftSize) {
+                Cell const& left = table[(leftSize - 1) * size + start];
+                Cell const& right = table[(subwordSize - leftSize - 1) * size + start + leftSize];
+                for (std::size_t w = 0; w < wordCount; ++w) {
+                    Word bits = left.words[w];
+                    for (; bits != 0; bits = static_cast<Word>(bits & (bits - 1))) {
+                        std::size_t leftChild = w * wordBits + lowestBit(bits);
+                        for (
+                            std::uint32_t r = rulesByLeftChild[leftChild];
+                            r < rulesByLeftChild[leftChild + 1];
+                            ++r
+                        ) {
+                            if (contains(right, rules[r].rightChild)) {
+                                insert(cell, rules[r].parent);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return contains(table[(size - 1) * size], startIndex);
+}
+
+bool recognize(std::string_view word) {
+    return recognize(word.data(), word.size());
+}
+
+}
+)";
+
+bool isIdentifier(std::string const& name) {
+    if (name.empty() || std::isdigit(static_cast<unsigned char>(name[0]))) {
+        return false;
+    }
+    return std::all_of(name.begin(), name.end(), [](char character) {
+        return std::isalnum(static_cast<unsigned char>(character)) || character == '_';
+    });
+}
+
+bool isNamespaceName(std::string const& name) {
+    size_t start = 0;
+    for (;;) {
+        auto end = name.find("::", start);
+        if (!isIdentifier(name.substr(start, end - start))) {
+            return false;
+        }
+        if (end == std::string::npos) {
+            return true;
+        }
+        start = end + 2;
+    }
+}
+
+}
+
+CodeGenerator::CodeGenerator(ContextFreeGrammar const& grammar, CodeGeneratorOptions const& options):
+    _options(options),
+    _terminalNonterminals(byteCount)
+{
+    if (!isNamespaceName(_options.namespaceName)) {
+        throw InvalidNamespaceException();
+    }
+
+    auto normalizedGrammar = grammar.normalized();
+    std::vector<Symbol> nonterminals(
+        normalizedGrammar.nonterminals().begin(),
+        normalizedGrammar.nonterminals().end()
+    );
+    std::sort(nonterminals.begin(), nonterminals.end(), [](Symbol lhs, Symbol rhs) {
+        return lhs.rawValue < rhs.rawValue;
+    });
+    std::unordered_map<Symbol, size_t> nonterminalIndices;
+    for (size_t i = 0; i < nonterminals.size(); ++i) {
+        nonterminalIndices[nonterminals[i]] = i;
+    }
+    _nonterminalCount = nonterminals.size();
+    _startIndex = nonterminalIndices.at(normalizedGrammar.startSymbol());
+
+    _acceptsEmptyWord = false;
+    std::vector<std::vector<BinaryRule>> rulesByLeftChild(_nonterminalCount);
+    for (auto const& [lhs, rhs]: normalizedGrammar.rules()) {
+        auto parent = nonterminalIndices.at(lhs[0]);
+        if (rhs.empty()) {
+            _acceptsEmptyWord |= parent == _startIndex;
+        } else if (rhs.size() == 1 && normalizedGrammar.symbolIsTerminal(rhs[0])) {
+            if (rhs[0].rawValue < -128 || rhs[0].rawValue >= static_cast<int>(byteCount)) {
+                throw NonByteTerminalException();
+            }
+            _terminalNonterminals[static_cast<unsigned char>(rhs[0].rawValue)].push_back(parent);
+        } else if (rhs.size() == 2) {
+            rulesByLeftChild[nonterminalIndices.at(rhs[0])].push_back({
+                nonterminalIndices.at(rhs[1]),
+                parent
+            });
+        }
+    }
+
+    _rulesByLeftChild.assign(1, 0);
+    for (auto& rules: rulesByLeftChild) {
+        std::sort(rules.begin(), rules.end(), [](BinaryRule const& lhs, BinaryRule const& rhs) {
+            return lhs.rightChild < rhs.rightChild ||
+                (lhs.rightChild == rhs.rightChild && lhs.parent < rhs.parent);
+        });
+        auto isSameRule = [](BinaryRule const& lhs, BinaryRule const& rhs) {
+            return lhs.rightChild == rhs.rightChild && lhs.parent == rhs.parent;
+        };
+        rules.erase(std::unique(rules.begin(), rules.end(), isSameRule), rules.end());
+        _binaryRules.insert(_binaryRules.end(), rules.begin(), rules.end());
+        _rulesByLeftChild.push_back(_binaryRules.size());
+    }
+}
+
+size_t CodeGenerator::nonterminalCount() const {
+    return _nonterminalCount;
+}
+
+size_t CodeGenerator::binaryRuleCount() const {
+    return _binaryRules.size();
+}
+
+std::string CodeGenerator::generate() const {
+    std::ostringstream stream;
+    write(stream);
+    return stream.str();
+}
+
+void CodeGenerator::write(std::ostream& stream) const {
+    auto const& name = _options.namespaceName;
+    stream <<
+        "// Generated by flp-codegen; do not edit.\n"
+        "//\n"
+        "// namespace " << name << " {\n"
+        "// bool recognize(char const* word, std::size_t size);\n"
+        "// bool recognize(std::string_view word);\n"
+        "// }\n"
+        "\n"
+        "#include <cstddef>\n"
+        "#include <cstdint>\n"
+        "#include <string_view>\n"
+        "#include <vector>\n"
+        "\n"
+        "namespace " << name << " {\n"
+        "\n"
+        "namespace {\n"
+        "\n";
+    writeConstants(stream);
+    writeRules(stream);
+    writeTerminalDispatch(stream);
+    stream << recognizerSource;
+}
+
+size_t CodeGenerator::wordBits() const {
+    for (size_t bits: {8, 16, 32}) {
+        if (_nonterminalCount <= bits) {
+            return bits;
+        }
+    }
+    return 64;
+}
+
+std::string CodeGenerator::wordType() const {
+    return "std::uint" + std::to_string(wordBits()) + "_t";
+}
+
+std::string CodeGenerator::cellValue(std::vector<size_t> const& nonterminals) const {
+    std::vector<std::uint64_t> words((_nonterminalCount + wordBits() - 1) / wordBits());
+    for (auto nonterminal: nonterminals) {
+        words[nonterminal / wordBits()] |= std::uint64_t(1) << (nonterminal % wordBits());
+    }
+
+    std::ostringstream value;
+    value << "{{" << std::hex;
+    for (size_t i = 0; i < words.size(); ++i) {
+        value << (i == 0 ? "" : ", ") << "0x" << words[i] << "u";
+    }
+    value << "}}";
+    return value.str();
+}
+
+void CodeGenerator::writeConstants(std::ostream& stream) const {
+    stream <<
+        "using Word = " << wordType() << ";\n"
+        "constexpr std::size_t wordBits = " << wordBits() << ";\n"
+        "constexpr std::size_t wordCount = " <<
+            std::max<size_t>((_nonterminalCount + wordBits() - 1) / wordBits(), 1) << ";\n"
+        "constexpr std::size_t startIndex = " << _startIndex << ";\n"
+        "constexpr bool acceptsEmptyWord = " << (_acceptsEmptyWord ? "true" : "false") << ";\n"
+        "\n"
+        "struct Cell {\n"
+        "    Word words[wordCount];\n"
+        "};\n"
+        "\n"
+        "struct Rule {\n"
+        "    std::uint32_t rightChild;\n"
+        "    std::uint32_t parent;\n"
+        "};\n"
+        "\n";
+}
+
+void CodeGenerator::writeRules(std::ostream& stream) const {
+    stream << "constexpr std::uint32_t rulesByLeftChild[] = {";
+    for (size_t i = 0; i < _rulesByLeftChild.size(); ++i) {
+        stream << (i % 16 == 0 ? "\n    " : " ") << _rulesByLeftChild[i] << ",";
+    }
+    stream << "\n};\n\nconstexpr Rule rules[] = {";
+    for (size_t i = 0; i < _binaryRules.size(); ++i) {
+        stream << (i % 8 == 0 ? "\n    " : " ") <<
+            "{" << _binaryRules[i].rightChild << ", " << _binaryRules[i].parent << "},";
+    }
+    if (_binaryRules.empty()) {
+        stream << "\n    {0, 0},";
+    }
+    stream << "\n};\n\n";
+}
+
+void CodeGenerator::writeTerminalDispatch(std::ostream& stream) const {
+    stream <<
+        "bool initCell(unsigned char character, Cell& cell) {\n"
+        "    switch (character) {\n";
+    for (size_t character = 0; character < byteCount; ++character) {
+        if (_terminalNonterminals[character].empty()) {
+            continue;
+        }
+        stream <<
+            "    case " << character << ":\n"
+            "        cell = Cell" << cellValue(_terminalNonterminals[character]) << ";\n"
+            "        return true;\n";
+    }
+    stream <<
+        "    default:\n"
+        "        return false;\n"
+        "    }\n"
+        "}\n";
+}
+
+char const* NonByteTerminalException::what() const throw() {
+    return "Generated recognizers only support single-byte terminals";
+}
+
+char const* InvalidNamespaceException::what() const throw() {
+    return "Namespace name is not a valid C++ identifier";
+}
+
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "ContextFreeGrammar.hpp"
+#include <ostream>
+#include <string>
+#include <vector>
+#include <exception>
+
+namespace FL {
+
+struct CodeGeneratorOptions {
+    std::string namespaceName = "GeneratedRecognizer";
+};
+
+class CodeGenerator {
+public:
+    explicit CodeGenerator(
+        ContextFreeGrammar const& grammar,
+        CodeGeneratorOptions const& options = {}
+    );
+
+    size_t nonterminalCount() const;
+    size_t binaryRuleCount() const;
+    std::string generate() const;
+    void write(std::ostream& stream) const;
+
+protected:
+    struct BinaryRule {
+        size_t rightChild;
+        size_t parent;
+    };
+
+    size_t wordBits() const;
+    std::string wordType() const;
+    std::string cellValue(std::vector<size_t> const& nonterminals) const;
+    void writeConstants(std::ostream& stream) const;
+    void writeRules(std::ostream& stream) const;
+    void writeTerminalDispatch(std::ostream& stream) const;
+
+    CodeGeneratorOptions _options;
+    size_t _nonterminalCount;
+    size_t _startIndex;
+    bool _acceptsEmptyWord;
+    std::vector<std::vector<size_t>> _terminalNonterminals;
+    std::vector<size_t> _rulesByLeftChild;
+    std::vector<BinaryRule> _binaryRules;
+};
+
+struct NonByteTerminalException: std::exception {
+    char const* what() const throw();
+};
+
+struct InvalidNamespaceException: std::exception {
+    char const* what() const throw();
+};
+
+}
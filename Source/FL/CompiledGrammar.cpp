@@ -0,0 +1,244 @@
+#include "CompiledGrammar.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace FL {
+
+namespace {
+
+constexpr std::uint64_t hashOffset = 0xcbf29ce484222325;
+constexpr std::uint64_t hashPrime = 0x100000001b3;
+
+std::uint64_t hashWords(std::uint64_t hash, std::uint64_t const* words, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ words[i]) * hashPrime;
+    }
+    return hash;
+}
+
+std::vector<Symbol> sortedSymbols(Alphabet const& alphabet) {
+    std::vector<Symbol> symbols(alphabet.begin(), alphabet.end());
+    std::sort(symbols.begin(), symbols.end(), [](Symbol lhs, Symbol rhs) {
+        return lhs.rawValue < rhs.rawValue;
+    });
+    return symbols;
+}
+
+}
+
+std::uint64_t grammarHash(ContextFreeGrammar const& grammar) {
+    CompiledGrammarWriter writer;
+    writer.write(grammar);
+    return writer.hash();
+}
+
+void CompiledGrammarWriter::write(std::uint64_t value) {
+    _payload.push_back(value);
+}
+
+void CompiledGrammarWriter::write(double value) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    write(bits);
+}
+
+void CompiledGrammarWriter::write(Symbol symbol) {
+    write(static_cast<std::uint64_t>(static_cast<std::uint32_t>(symbol.rawValue)));
+}
+
+void CompiledGrammarWriter::write(Word const& word) {
+    write(static_cast<std::uint64_t>(word.size()));
+    for (auto symbol: word) {
+        write(symbol);
+    }
+}
+
+void CompiledGrammarWriter::write(ContextFreeGrammar const& grammar) {
+    write(sortedSymbols(grammar.terminals()));
+    write(sortedSymbols(grammar.nonterminals()));
+    write(grammar.startSymbol());
+    write(static_cast<std::uint64_t>(grammar.rules().size()));
+    for (auto const& rule: grammar.rules()) {
+        write(rule.lhs);
+        write(rule.rhs);
+        write(rule.probability);
+    }
+
+    std::vector<std::pair<Symbol, Word>> auxiliaryNonterminals(
+        grammar.auxiliaryNonterminals().begin(),
+        grammar.auxiliaryNonterminals().end()
+    );
+    std::sort(
+        auxiliaryNonterminals.begin(),
+        auxiliaryNonterminals.end(),
+        [](auto const& lhs, auto const& rhs) {
+            return lhs.first.rawValue < rhs.first.rawValue;
+        }
+    );
+    write(static_cast<std::uint64_t>(auxiliaryNonterminals.size()));
+    for (auto const& [nonterminal, sequence]: auxiliaryNonterminals) {
+        write(nonterminal);
+        write(sequence);
+    }
+}
+
+std::uint64_t CompiledGrammarWriter::hash() const {
+    return hashWords(hashOffset, _payload.data(), _payload.size());
+}
+
+void CompiledGrammarWriter::save(std::string const& path, std::uint64_t sourceHash) const {
+    CompiledGrammarHeader header{
+        CompiledGrammarHeader::expectedMagic,
+        CompiledGrammarHeader::currentVersion,
+        CompiledGrammarHeader::expectedByteOrder,
+        sourceHash,
+        hash(),
+        _payload.size()
+    };
+
+    std::string temporaryPath = path + ".tmp";
+    {
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<char const*>(&header), sizeof(header));
+        file.write(
+            reinterpret_cast<char const*>(_payload.data()),
+            _payload.size() * sizeof(std::uint64_t)
+        );
+        if (!file) {
+            throw CompiledGrammarException();
+        }
+    }
+    if (std::rename(temporaryPath.c_str(), path.c_str()) != 0) {
+        std::remove(temporaryPath.c_str());
+        throw CompiledGrammarException();
+    }
+}
+
+CompiledGrammarReader::CompiledGrammarReader(std::string const& path) {
+    int descriptor = open(path.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        throw CompiledGrammarException();
+    }
+    struct stat status;
+    if (
+        fstat(descriptor, &status) != 0 ||
+        status.st_size < static_cast<off_t>(sizeof(CompiledGrammarHeader))
+    ) {
+        close(descriptor);
+        throw CompiledGrammarException();
+    }
+    _size = status.st_size;
+    _data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    close(descriptor);
+    if (_data == MAP_FAILED) {
+        _data = nullptr;
+        throw CompiledGrammarException();
+    }
+
+    auto const& header = this->header();
+    _payload = reinterpret_cast<std::uint64_t const*>(&header + 1);
+    _payloadSize = header.payloadSize;
+    if (
+        header.magic != CompiledGrammarHeader::expectedMagic ||
+        header.version != CompiledGrammarHeader::currentVersion ||
+        header.byteOrder != CompiledGrammarHeader::expectedByteOrder ||
+        _payloadSize > (_size - sizeof(header)) / sizeof(std::uint64_t) ||
+        _size != sizeof(header) + _payloadSize * sizeof(std::uint64_t) ||
+        hashWords(hashOffset, _payload, _payloadSize) != header.payloadHash
+    ) {
+        unmap();
+        throw CompiledGrammarException();
+    }
+}
+
+CompiledGrammarReader::~CompiledGrammarReader() {
+    unmap();
+}
+
+CompiledGrammarHeader const& CompiledGrammarReader::header() const {
+    return *static_cast<CompiledGrammarHeader const*>(_data);
+}
+
+std::uint64_t const* CompiledGrammarReader::read(size_t size) {
+    if (size > _payloadSize - _position) {
+        throw CompiledGrammarException();
+    }
+    auto values = _payload + _position;
+    _position += size;
+    return values;
+}
+
+std::uint64_t CompiledGrammarReader::readValue() {
+    return *read(1);
+}
+
+double CompiledGrammarReader::readDouble() {
+    double value;
+    std::memcpy(&value, read(1), sizeof(value));
+    return value;
+}
+
+Symbol CompiledGrammarReader::readSymbol() {
+    return static_cast<int>(static_cast<std::uint32_t>(readValue()));
+}
+
+Word CompiledGrammarReader::readWord() {
+    size_t size = readValue();
+    auto values = read(size);
+    Word word;
+    word.reserve(size);
+    for (size_t i = 0; i < size; ++i) {
+        word.push_back(static_cast<int>(static_cast<std::uint32_t>(values[i])));
+    }
+    return word;
+}
+
+ContextFreeGrammar CompiledGrammarReader::readGrammar() {
+    auto terminals = readWord();
+    auto nonterminals = readWord();
+    auto startSymbol = readSymbol();
+
+    std::vector<Grammar::Rule> rules;
+    size_t ruleCount = readValue();
+    rules.reserve(std::min(ruleCount, _payloadSize));
+    for (size_t i = 0; i < ruleCount; ++i) {
+        auto lhs = readWord();
+        auto rhs = readWord();
+        rules.emplace_back(lhs, rhs, readDouble());
+    }
+
+    std::unordered_map<Symbol, Word> auxiliaryNonterminals;
+    size_t auxiliaryNonterminalCount = readValue();
+    for (size_t i = 0; i < auxiliaryNonterminalCount; ++i) {
+        auto nonterminal = readSymbol();
+        auxiliaryNonterminals.emplace(nonterminal, readWord());
+    }
+
+    return ContextFreeGrammar(
+        Alphabet(terminals.begin(), terminals.end()),
+        Alphabet(nonterminals.begin(), nonterminals.end()),
+        startSymbol,
+        rules,
+        auxiliaryNonterminals
+    );
+}
+
+void CompiledGrammarReader::unmap() {
+    if (_data) {
+        munmap(_data, _size);
+        _data = nullptr;
+    }
+}
+
+char const* CompiledGrammarException::what() const throw() {
+    return "Compiled grammar file is missing, corrupted or has an unsupported version";
+}
+
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "ContextFreeGrammar.hpp"
+#include <string>
+#include <vector>
+#include <exception>
+#include <cstdint>
+
+namespace FL {
+
+struct CompiledGrammarHeader {
+    static constexpr std::uint64_t expectedMagic = 0x31524d5247504c46;
+    static constexpr std::uint32_t currentVersion = 1;
+    static constexpr std::uint32_t expectedByteOrder = 0x01020304;
+
+    std::uint64_t magic;
+    std::uint32_t version;
+    std::uint32_t byteOrder;
+    std::uint64_t sourceHash;
+    std::uint64_t payloadHash;
+    std::uint64_t payloadSize;
+};
+
+std::uint64_t grammarHash(ContextFreeGrammar const& grammar);
+
+class CompiledGrammarWriter {
+public:
+    void write(std::uint64_t value);
+    void write(double value);
+    void write(Symbol symbol);
+    void write(Word const& word);
+    void write(ContextFreeGrammar const& grammar);
+    std::uint64_t hash() const;
+    void save(std::string const& path, std::uint64_t sourceHash) const;
+
+protected:
+    std::vector<std::uint64_t> _payload;
+};
+
+class CompiledGrammarReader {
+public:
+    explicit CompiledGrammarReader(std::string const& path);
+    CompiledGrammarReader(CompiledGrammarReader const&) = delete;
+    ~CompiledGrammarReader();
+
+    CompiledGrammarReader& operator=(CompiledGrammarReader const&) = delete;
+
+    CompiledGrammarHeader const& header() const;
+    std::uint64_t const* read(size_t size);
+    std::uint64_t readValue();
+    double readDouble();
+    Symbol readSymbol();
+    Word readWord();
+    ContextFreeGrammar readGrammar();
+
+protected:
+    void unmap();
+
+    void* _data = nullptr;
+    size_t _size = 0;
+    std::uint64_t const* _payload = nullptr;
+    size_t _payloadSize = 0;
+    size_t _position = 0;
+};
+
+struct CompiledGrammarException: std::exception {
+    char const* what() const throw();
+};
+
+}
@@ -1,9 +1,11 @@
 #pragma once
 
 #include "Common.hpp"
+#include <cstddef>
 
 namespace FL {
 
 Word const emptyWord = {};
+constexpr size_t bitsPerCellWord = 64;
 
 }
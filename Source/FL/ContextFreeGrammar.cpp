@@ -1,6 +1,9 @@
 #include "ContextFreeGrammar.hpp"
 
 #include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
 #include <unordered_map>
 
 namespace FL {
@@ -17,9 +20,11 @@ ContextFreeGrammar::ContextFreeGrammar(
     Alphabet const& terminals,
     Alphabet const& nonterminals,
     Symbol startSymbol,
-    std::vector<Rule> const& rules
+    std::vector<Rule> const& rules,
+    std::unordered_map<Symbol, Word> const& auxiliaryNonterminals
 ):
-    Grammar(terminals, nonterminals, startSymbol, rules)
+    Grammar(terminals, nonterminals, startSymbol, rules),
+    _auxiliaryNonterminals(auxiliaryNonterminals)
 {
     if (!isContextFree()) {
         throw NonContextFreeGrammarException();
@@ -44,25 +49,109 @@ bool ContextFreeGrammar::isNormalized() const {
     return true;
 }
 
-void ContextFreeGrammar::normalize() {
-    if (isNormalized()) {
-        return;
+double NormalizationReport::predictedSplitCost() const {
+    return static_cast<double>(binaryRuleCount + cellWordCount);
+}
+
+double NormalizationReport::predictedCellCost(size_t subwordSize) const {
+    return subwordSize > 1 ? (subwordSize - 1) * predictedSplitCost() : 0;
+}
+
+std::string NormalizationReport::toText() const {
+    std::ostringstream text;
+    text << std::fixed << std::setprecision(6);
+    for (auto const& phase: phases) {
+        text << phase.name << ": " << phase.seconds << " s";
+        text << ", nonterminals " << phase.nonterminalCountBefore;
+        text << " -> " << phase.nonterminalCountAfter;
+        text << ", rules " << phase.ruleCountBefore << " -> " << phase.ruleCountAfter;
+        text << ", fresh nonterminals " << phase.freshNonterminalCount << '\n';
+    }
+    text << "total: " << seconds << " s\n";
+    text << "normalized: " << nonterminalCount << " nonterminals, ";
+    text << binaryRuleCount << " binary rules, " << terminalRuleCount << " terminal rules\n";
+    text << std::setprecision(0);
+    text << "predicted CYK cost: " << predictedSplitCost() << " operations per split, ";
+    text << predictedCellCost(64) << " per cell of size 64\n";
+    return text.str();
+}
+
+void ContextFreeGrammar::normalize(NormalizationReport* report) {
+    auto startTime = std::chrono::steady_clock::now();
+    if (report) {
+        report->phases.clear();
     }
 
-    removeLongRules();
-    removeEmptyRules();
-    removeChainRules();
-    removeNonGeneratingRules();
-    removeNonReachableRules();
-    removeMixedRules();
+    if (!isNormalized()) {
+        runPhase(report, "long rules", &ContextFreeGrammar::removeLongRules);
+        runPhase(report, "empty rules", &ContextFreeGrammar::removeEmptyRules);
+        runPhase(report, "chain rules", &ContextFreeGrammar::removeChainRules);
+        runPhase(report, "non-generating", &ContextFreeGrammar::removeNonGeneratingRules);
+        runPhase(report, "non-reachable", &ContextFreeGrammar::removeNonReachableRules);
+        runPhase(report, "mixed rules", &ContextFreeGrammar::removeMixedRules);
+    }
+
+    if (report) {
+        report->seconds = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - startTime
+        ).count();
+        describeShape(*report);
+    }
 }
 
-ContextFreeGrammar ContextFreeGrammar::normalized() const {
+ContextFreeGrammar ContextFreeGrammar::normalized(NormalizationReport* report) const {
     auto copy = *this;
-    copy.normalize();
+    copy.normalize(report);
     return copy;
 }
 
+std::unordered_map<Symbol, Word> const& ContextFreeGrammar::auxiliaryNonterminals() const {
+    return _auxiliaryNonterminals;
+}
+
+Symbol ContextFreeGrammar::addAuxiliaryNonterminal(Word const& sequence) {
+    auto nonterminal = addNewNonterminal();
+    _auxiliaryNonterminals.emplace(nonterminal, sequence);
+    return nonterminal;
+}
+
+void ContextFreeGrammar::runPhase(
+    NormalizationReport* report,
+    char const* name,
+    void (ContextFreeGrammar::*phase)()
+) {
+    if (!report) {
+        (this->*phase)();
+        return;
+    }
+
+    NormalizationPhase statistics;
+    statistics.name = name;
+    statistics.nonterminalCountBefore = _nonterminals.size();
+    statistics.ruleCountBefore = _rules.size();
+    auto maxSymbol = _maxSymbol.rawValue;
+    auto startTime = std::chrono::steady_clock::now();
+    (this->*phase)();
+    statistics.seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - startTime
+    ).count();
+    statistics.nonterminalCountAfter = _nonterminals.size();
+    statistics.ruleCountAfter = _rules.size();
+    statistics.freshNonterminalCount = _maxSymbol.rawValue - maxSymbol;
+    report->phases.push_back(std::move(statistics));
+}
+
+void ContextFreeGrammar::describeShape(NormalizationReport& report) const {
+    report.nonterminalCount = _nonterminals.size();
+    report.binaryRuleCount = 0;
+    report.terminalRuleCount = 0;
+    for (auto const& [lhs, rhs]: _rules) {
+        report.binaryRuleCount += rhs.size() == 2;
+        report.terminalRuleCount += rhs.size() == 1;
+    }
+    report.cellWordCount = (_nonterminals.size() + bitsPerCellWord - 1) / bitsPerCellWord;
+}
+
 bool ContextFreeGrammar::hasLongRules() const {
     for (auto const& [lhs, rhs]: _rules) {
         if (rhs.size() > 2) {
@@ -75,13 +164,21 @@ bool ContextFreeGrammar::hasLongRules() const {
 void ContextFreeGrammar::removeLongRules() {
     for (int i = static_cast<int>(_rules.size()) - 1; i >= 0; --i) {
         auto [lhs, rhs] = _rules[i];
+        auto probability = _rules[i].probability;
         if (rhs.size() <= 2) {
             continue;
         }
 
-        _rules.emplace_back(lhs, Word{rhs[0], addNewNonterminal()});
+        _rules.emplace_back(
+            lhs,
+            Word{rhs[0], addAuxiliaryNonterminal(Word(rhs.begin() + 1, rhs.end()))},
+            probability
+        );
         for (size_t j = 1; j < rhs.size() - 2; ++j) {
-            _rules.emplace_back(Word{_rules.back().rhs[1]}, Word{rhs[j], addNewNonterminal()});
+            _rules.emplace_back(
+                Word{_rules.back().rhs[1]},
+                Word{rhs[j], addAuxiliaryNonterminal(Word(rhs.begin() + j + 1, rhs.end()))}
+            );
         }
         _rules.emplace_back(Word{_rules.back().rhs[1]}, Word{rhs[rhs.size() - 2], rhs.back()});
 
@@ -121,14 +218,45 @@ std::unordered_set<Symbol> ContextFreeGrammar::findEpsilonGenerators() const {
     return generators;
 }
 
+std::unordered_map<Symbol, double> ContextFreeGrammar::findEpsilonProbabilities() const {
+    auto epsilonGenerators = findEpsilonGenerators();
+    std::unordered_map<Symbol, double> probabilities;
+    for (auto symbol: epsilonGenerators) {
+        probabilities[symbol] = 0;
+    }
+
+    for (size_t round = 0; round <= epsilonGenerators.size(); ++round) {
+        bool foundBetterDerivation = false;
+        for (auto const& rule: _rules) {
+            if (!epsilonGenerators.count(rule.lhs[0])) {
+                continue;
+            }
+            double probability = rule.probability;
+            for (auto symbol: rule.rhs) {
+                probability *= epsilonGenerators.count(symbol) ? probabilities[symbol] : 0;
+            }
+            if (probability > probabilities[rule.lhs[0]]) {
+                probabilities[rule.lhs[0]] = probability;
+                foundBetterDerivation = true;
+            }
+        }
+        if (!foundBetterDerivation) {
+            break;
+        }
+    }
+
+    return probabilities;
+}
+
 void ContextFreeGrammar::removeEmptyRules() {
     if (hasLongRules()) {
         throw FoundLongRuleException();
     }
 
-    auto epsilonGenerators = findEpsilonGenerators();
+    auto epsilonProbabilities = findEpsilonProbabilities();
     for (int i = static_cast<int>(_rules.size()) - 1; i >= 0; --i) {
         auto [lhs, rhs] = _rules[i];
+        auto probability = _rules[i].probability;
         if (rhs.empty()) {
             _rules.erase(_rules.begin() + i);
         }
@@ -136,15 +264,16 @@ void ContextFreeGrammar::removeEmptyRules() {
             continue;
         }
         for (size_t j = 0; j < 2; ++j) {
-            if (epsilonGenerators.count(rhs[j])) {
-                _rules.emplace_back(lhs, Word{rhs[1 - j]});
+            auto epsilonProbability = epsilonProbabilities.find(rhs[j]);
+            if (epsilonProbability != epsilonProbabilities.end()) {
+                _rules.emplace_back(lhs, Word{rhs[1 - j]}, probability * epsilonProbability->second);
             }
         }
     }
 
-    if (epsilonGenerators.count(_startSymbol)) {
-        auto newStartSymbol = addNewNonterminal();
-        _rules.emplace_back(Word{newStartSymbol}, emptyWord);
+    if (epsilonProbabilities.count(_startSymbol)) {
+        auto newStartSymbol = addAuxiliaryNonterminal(Word{_startSymbol});
+        _rules.emplace_back(Word{newStartSymbol}, emptyWord, epsilonProbabilities[_startSymbol]);
         _rules.emplace_back(Word{newStartSymbol}, Word{_startSymbol});
         _startSymbol = newStartSymbol;
     }
@@ -179,8 +308,46 @@ std::vector<std::pair<Symbol, Symbol>> ContextFreeGrammar::findChainedPairs() co
     return pairs;
 }
 
+std::unordered_map<Symbol, std::unordered_map<Symbol, double>>
+ContextFreeGrammar::findChainProbabilities() const {
+    std::unordered_map<Symbol, std::unordered_map<Symbol, double>> probabilities;
+    for (auto const& rule: _rules) {
+        if (rule.rhs.size() == 1 && symbolIsNonterminal(rule.rhs[0])) {
+            auto& probability = probabilities[rule.lhs[0]][rule.rhs[0]];
+            probability = std::max(probability, rule.probability);
+        }
+    }
+
+    for (size_t round = 0; round <= _nonterminals.size(); ++round) {
+        bool foundBetterChain = false;
+        for (auto const& rule: _rules) {
+            if (rule.rhs.size() != 1 || !symbolIsNonterminal(rule.rhs[0])) {
+                continue;
+            }
+            for (auto& [start, ends]: probabilities) {
+                auto end = ends.find(rule.lhs[0]);
+                if (end == ends.end()) {
+                    continue;
+                }
+                auto probability = end->second * rule.probability;
+                auto& bestProbability = ends[rule.rhs[0]];
+                if (probability > bestProbability) {
+                    bestProbability = probability;
+                    foundBetterChain = true;
+                }
+            }
+        }
+        if (!foundBetterChain) {
+            break;
+        }
+    }
+
+    return probabilities;
+}
+
 void ContextFreeGrammar::removeChainRules() {
     auto chainedPairs = findChainedPairs();
+    auto chainProbabilities = findChainProbabilities();
     for (int i = static_cast<int>(_rules.size()) - 1; i >= 0; --i) {
         if (_rules[i].rhs.size() == 1 && symbolIsNonterminal(_rules[i].rhs[0])) {
             _rules.erase(_rules.begin() + i);
@@ -190,7 +357,11 @@ void ContextFreeGrammar::removeChainRules() {
         for (int i = static_cast<int>(_rules.size()) - 1; i >= 0; --i) {
             auto [lhs, rhs] = _rules[i];
             if (lhs[0] == end) {
-                _rules.emplace_back(Word{start}, rhs);
+                _rules.emplace_back(
+                    Word{start},
+                    rhs,
+                    chainProbabilities[start][end] * _rules[i].probability
+                );
             }
         }
     }
@@ -248,6 +419,7 @@ void ContextFreeGrammar::removeNonGeneratingRules() {
             _rules.erase(_rules.begin() + i);
         }
     }
+    keepNonterminals(generatingNonterminals);
 }
 
 std::unordered_set<Symbol> ContextFreeGrammar::findReachableNonterminals() const {
@@ -286,6 +458,18 @@ void ContextFreeGrammar::removeNonReachableRules() {
             _rules.erase(_rules.begin() + i);
         }
     }
+    keepNonterminals(reachableNonterminals);
+}
+
+void ContextFreeGrammar::keepNonterminals(std::unordered_set<Symbol> const& nonterminals) {
+    for (auto nonterminal = _nonterminals.begin(); nonterminal != _nonterminals.end();) {
+        if (*nonterminal != _startSymbol && !nonterminals.count(*nonterminal)) {
+            _auxiliaryNonterminals.erase(*nonterminal);
+            nonterminal = _nonterminals.erase(nonterminal);
+        } else {
+            ++nonterminal;
+        }
+    }
 }
 
 void ContextFreeGrammar::removeMixedRules() {
@@ -298,14 +482,21 @@ void ContextFreeGrammar::removeMixedRules() {
         if (rhs.size() < 2 || (symbolIsNonterminal(rhs[0]) && symbolIsNonterminal(rhs[1]))) {
             continue;
         }
+        auto probability = _rules[i].probability;
         if (symbolIsNonterminal(rhs[0]) && symbolIsTerminal(rhs[1])) {
-            _rules.emplace_back(lhs, Word{rhs[0], addNewNonterminal()});
+            auto nonterminal = addAuxiliaryNonterminal(Word{rhs[1]});
+            _rules.emplace_back(lhs, Word{rhs[0], nonterminal}, probability);
             _rules.emplace_back(Word{_rules.back().rhs[1]}, Word{rhs[1]});
         } else if (symbolIsTerminal(rhs[0]) && symbolIsNonterminal(rhs[1])) {
-            _rules.emplace_back(lhs, Word{addNewNonterminal(), rhs[1]});
+            auto nonterminal = addAuxiliaryNonterminal(Word{rhs[0]});
+            _rules.emplace_back(lhs, Word{nonterminal, rhs[1]}, probability);
             _rules.emplace_back(Word{_rules.back().rhs[0]}, Word{rhs[0]});
         } else {
-            Rule newRule(lhs, Word{addNewNonterminal(), addNewNonterminal()});
+            Rule newRule(
+                lhs,
+                Word{addAuxiliaryNonterminal(Word{rhs[0]}), addAuxiliaryNonterminal(Word{rhs[1]})},
+                probability
+            );
             _rules.emplace_back(Word{newRule.rhs[0]}, Word{rhs[0]});
             _rules.emplace_back(Word{newRule.rhs[1]}, Word{rhs[1]});
             _rules.emplace_back(std::move(newRule));
@@ -1,10 +1,35 @@
 #pragma once
 
 #include "Grammar.hpp"
+#include <string>
 #include <unordered_set>
+#include <unordered_map>
 
 namespace FL {
 
+struct NormalizationPhase {
+    std::string name;
+    double seconds = 0;
+    size_t nonterminalCountBefore = 0;
+    size_t nonterminalCountAfter = 0;
+    size_t ruleCountBefore = 0;
+    size_t ruleCountAfter = 0;
+    size_t freshNonterminalCount = 0;
+};
+
+struct NormalizationReport {
+    std::vector<NormalizationPhase> phases;
+    double seconds = 0;
+    size_t nonterminalCount = 0;
+    size_t binaryRuleCount = 0;
+    size_t terminalRuleCount = 0;
+    size_t cellWordCount = 0;
+
+    double predictedSplitCost() const;
+    double predictedCellCost(size_t subwordSize) const;
+    std::string toText() const;
+};
+
 class ContextFreeGrammar: public Grammar {
 public:
     ContextFreeGrammar(Grammar const& grammar);
@@ -12,25 +37,39 @@ public:
         Alphabet const& terminals,
         Alphabet const& nonterminals,
         Symbol startSymbol,
-        std::vector<Rule> const& rules
+        std::vector<Rule> const& rules,
+        std::unordered_map<Symbol, Word> const& auxiliaryNonterminals = {}
     );
 
     bool isNormalized() const;
-    void normalize();
-    ContextFreeGrammar normalized() const;
+    void normalize(NormalizationReport* report = nullptr);
+    ContextFreeGrammar normalized(NormalizationReport* report = nullptr) const;
+    std::unordered_map<Symbol, Word> const& auxiliaryNonterminals() const;
 
 protected:
+    Symbol addAuxiliaryNonterminal(Word const& sequence);
+    void runPhase(
+        NormalizationReport* report,
+        char const* name,
+        void (ContextFreeGrammar::*phase)()
+    );
+    void describeShape(NormalizationReport& report) const;
     bool hasLongRules() const;
     void removeLongRules();
     std::unordered_set<Symbol> findEpsilonGenerators() const;
+    std::unordered_map<Symbol, double> findEpsilonProbabilities() const;
     void removeEmptyRules();
     std::vector<std::pair<Symbol, Symbol>> findChainedPairs() const;
+    std::unordered_map<Symbol, std::unordered_map<Symbol, double>> findChainProbabilities() const;
     void removeChainRules();
     std::unordered_set<Symbol> findGeneratingNonterminals() const;
     void removeNonGeneratingRules();
     std::unordered_set<Symbol> findReachableNonterminals() const;
     void removeNonReachableRules();
     void removeMixedRules();
+    void keepNonterminals(std::unordered_set<Symbol> const& nonterminals);
+
+    std::unordered_map<Symbol, Word> _auxiliaryNonterminals;
 };
 
 struct NonContextFreeGrammarException: std::exception {
@@ -123,12 +123,15 @@ Symbol Grammar::addNewNonterminal() {
     return _maxSymbol;
 }
 
-Grammar::Rule::Rule(Word const& lhs, Word const& rhs):
+Grammar::Rule::Rule(Word const& lhs, Word const& rhs, double probability):
     lhs(lhs),
-    rhs(rhs)
+    rhs(rhs),
+    probability(probability)
 {}
 
-Grammar::Rule::Rule(std::string const& lhs, std::string const& rhs) {
+Grammar::Rule::Rule(std::string const& lhs, std::string const& rhs, double probability):
+    probability(probability)
+{
     for (auto character: lhs) {
         this->lhs.emplace_back(character);
     }
@@ -138,7 +141,11 @@ Grammar::Rule::Rule(std::string const& lhs, std::string const& rhs) {
 }
 
 bool Grammar::Rule::operator==(Rule const& rule) const {
-    if (lhs.size() != rule.lhs.size() || rhs.size() != rule.rhs.size()) {
+    if (
+        lhs.size() != rule.lhs.size() ||
+        rhs.size() != rule.rhs.size() ||
+        probability != rule.probability
+    ) {
         return false;
     }
 
@@ -5,6 +5,7 @@
 #include <vector>
 #include <string>
 #include <exception>
+#include <utility>
 
 namespace FL {
 
@@ -13,12 +14,18 @@ public:
     struct Rule {
         Word lhs;
         Word rhs;
+        double probability;
 
-        Rule(Word const& lhs, Word const& rhs);
-        Rule(std::string const& lhs, std::string const& rhs);
+        Rule(Word const& lhs, Word const& rhs, double probability = 1);
+        Rule(std::string const& lhs, std::string const& rhs, double probability = 1);
 
         bool operator==(Rule const& rule) const;
         bool operator!=(Rule const& rule) const;
+
+        template<size_t I>
+        Word& get();
+        template<size_t I>
+        Word const& get() const;
     };
 
     Grammar(
@@ -61,4 +68,27 @@ struct GrammarOutOfSymbolsException: std::exception {
     char const* what() const throw();
 };
 
+template<size_t I>
+Word& Grammar::Rule::get() {
+    return I == 0 ? lhs : rhs;
+}
+
+template<size_t I>
+Word const& Grammar::Rule::get() const {
+    return I == 0 ? lhs : rhs;
+}
+
+}
+
+// Rules decompose into (lhs, rhs) in structured bindings; probability is accessed by name.
+namespace std {
+
+template<>
+struct tuple_size<FL::Grammar::Rule>: integral_constant<size_t, 2> {};
+
+template<size_t I>
+struct tuple_element<I, FL::Grammar::Rule> {
+    using type = FL::Word;
+};
+
 }
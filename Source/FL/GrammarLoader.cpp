@@ -0,0 +1,374 @@
+#include "GrammarLoader.hpp"
+
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace FL {
+
+GrammarLoader::GrammarLoader(std::string_view text):
+    _text(text),
+    _position(0),
+    _line(1),
+    _startSymbol(0),
+    _helperCount(0)
+{
+    skipSpace();
+    while (!atEnd()) {
+        parseRule();
+        skipSpace();
+    }
+    if (_rules.empty()) {
+        fail("Grammar has no rules");
+    }
+    for (size_t i = 0; i < _names.size(); ++i) {
+        if (!_isDefined[i]) {
+            throw GrammarFormatException("Undefined nonterminal", _firstUseLines[i]);
+        }
+    }
+
+    for (size_t i = 0; i < _usedCharacters.size(); ++i) {
+        if (_usedCharacters[i]) {
+            _terminals.emplace(static_cast<char>(i));
+        }
+    }
+    _helpers.clear();
+    _text = {};
+}
+
+GrammarLoader GrammarLoader::load(std::string const& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw GrammarFormatException("Could not open grammar file", 0);
+    }
+    std::string text(std::istreambuf_iterator<char>(file), {});
+    return GrammarLoader(text);
+}
+
+ContextFreeGrammar GrammarLoader::grammar() const {
+    return ContextFreeGrammar(_terminals, _nonterminals, _startSymbol, _rules);
+}
+
+Alphabet const& GrammarLoader::terminals() const {
+    return _terminals;
+}
+
+Alphabet const& GrammarLoader::nonterminals() const {
+    return _nonterminals;
+}
+
+Symbol GrammarLoader::startSymbol() const {
+    return _startSymbol;
+}
+
+std::vector<Grammar::Rule> const& GrammarLoader::rules() const {
+    return _rules;
+}
+
+size_t GrammarLoader::helperCount() const {
+    return _helperCount;
+}
+
+bool GrammarLoader::hasNonterminal(std::string_view name) const {
+    return _nonterminalsByName.count(name);
+}
+
+Symbol GrammarLoader::nonterminal(std::string_view name) const {
+    auto nonterminal = _nonterminalsByName.find(name);
+    if (nonterminal == _nonterminalsByName.end()) {
+        throw UnknownNonterminalException();
+    }
+    return nonterminal->second;
+}
+
+std::string const& GrammarLoader::nonterminalName(Symbol nonterminal) const {
+    size_t index = nonterminal.rawValue - firstNonterminal;
+    if (nonterminal.rawValue < firstNonterminal || index >= _names.size()) {
+        throw UnknownNonterminalException();
+    }
+    return _names[index];
+}
+
+bool GrammarLoader::atEnd() const {
+    return _position == _text.size();
+}
+
+void GrammarLoader::skipSpace() {
+    while (!atEnd()) {
+        char character = _text[_position];
+        if (character == '#') {
+            while (!atEnd() && _text[_position] != '\n') {
+                ++_position;
+            }
+        } else if (std::isspace(static_cast<unsigned char>(character))) {
+            _line += character == '\n';
+            ++_position;
+        } else {
+            break;
+        }
+    }
+}
+
+bool GrammarLoader::nameStartsAt(size_t position) const {
+    if (position >= _text.size()) {
+        return false;
+    }
+    char character = _text[position];
+    return std::isalpha(static_cast<unsigned char>(character)) ||
+        character == '_' ||
+        character == '<';
+}
+
+std::string_view GrammarLoader::parseName() {
+    size_t nameStart = _position;
+    if (_text[_position] == '<') {
+        while (++_position < _text.size() && _text[_position] != '>') {
+            if (_text[_position] == '\n') {
+                fail("Unterminated nonterminal name");
+            }
+        }
+        if (atEnd()) {
+            fail("Unterminated nonterminal name");
+        }
+        ++_position;
+        return _text.substr(nameStart + 1, _position - nameStart - 2);
+    }
+
+    while (
+        !atEnd() && (
+            std::isalnum(static_cast<unsigned char>(_text[_position])) ||
+            _text[_position] == '_' ||
+            _text[_position] == '-'
+        )
+    ) {
+        ++_position;
+    }
+    return _text.substr(nameStart, _position - nameStart);
+}
+
+void GrammarLoader::parseRule() {
+    if (!nameStartsAt(_position)) {
+        fail("Expected nonterminal name");
+    }
+    auto lhs = addNonterminal(parseName());
+    _isDefined[lhs.rawValue - firstNonterminal] = true;
+    if (_rules.empty()) {
+        _startSymbol = lhs;
+    }
+
+    skipSpace();
+    if (_text.compare(_position, 3, "::=") != 0) {
+        fail("Expected ::=");
+    }
+    _position += 3;
+
+    Word sequence;
+    for (;;) {
+        sequence.clear();
+        parseSequence(sequence);
+        _rules.emplace_back(Word{lhs}, sequence);
+        if (atEnd() || _text[_position] != '|') {
+            break;
+        }
+        ++_position;
+    }
+    if (!atEnd() && _text[_position] == ';') {
+        ++_position;
+    }
+}
+
+void GrammarLoader::parseSequence(Word& sequence) {
+    for (;;) {
+        skipSpace();
+        if (atEnd() || std::strchr("|;)]}", _text[_position])) {
+            return;
+        }
+
+        if (nameStartsAt(_position)) {
+            size_t position = _position;
+            size_t line = _line;
+            parseName();
+            skipSpace();
+            bool startsRule = _text.compare(_position, 3, "::=") == 0;
+            _position = position;
+            _line = line;
+            if (startsRule) {
+                return;
+            }
+        }
+
+        parseItem(sequence);
+    }
+}
+
+GrammarLoader::Alternatives GrammarLoader::parseAlternatives(char closing) {
+    Alternatives alternatives(1);
+    for (;;) {
+        parseSequence(alternatives.back());
+        if (atEnd()) {
+            fail("Expected closing bracket");
+        }
+        if (_text[_position] == closing) {
+            ++_position;
+            return alternatives;
+        }
+        if (_text[_position] != '|') {
+            fail("Expected closing bracket");
+        }
+        ++_position;
+        alternatives.emplace_back();
+    }
+}
+
+void GrammarLoader::parseItem(Word& sequence) {
+    size_t itemStart = sequence.size();
+    char character = _text[_position];
+    Alternatives alternatives;
+    bool isGroup = false;
+    if (character == '(') {
+        ++_position;
+        alternatives = parseAlternatives(')');
+        isGroup = true;
+    } else if (character == '[') {
+        ++_position;
+        alternatives = parseAlternatives(']');
+        alternatives.emplace_back();
+        sequence.push_back(addHelper(HelperKind::Choice, alternatives));
+    } else if (character == '{') {
+        ++_position;
+        sequence.push_back(addHelper(HelperKind::Star, parseAlternatives('}')));
+    } else if (character == '\'' || character == '"') {
+        parseTerminal(sequence);
+    } else if (nameStartsAt(_position)) {
+        sequence.push_back(addNonterminal(parseName()));
+    } else {
+        fail("Unexpected character");
+    }
+
+    char suffix = atEnd() ? '\0' : _text[_position];
+    if (suffix != '*' && suffix != '+' && suffix != '?') {
+        if (isGroup && alternatives.size() == 1) {
+            sequence.insert(sequence.end(), alternatives[0].begin(), alternatives[0].end());
+        } else if (isGroup) {
+            sequence.push_back(addHelper(HelperKind::Choice, alternatives));
+        }
+        return;
+    }
+
+    ++_position;
+    if (!isGroup) {
+        alternatives.emplace_back(sequence.begin() + itemStart, sequence.end());
+        sequence.erase(sequence.begin() + itemStart, sequence.end());
+    }
+    if (suffix == '?') {
+        alternatives.emplace_back();
+        sequence.push_back(addHelper(HelperKind::Choice, alternatives));
+    } else {
+        sequence.push_back(
+            addHelper(suffix == '*' ? HelperKind::Star : HelperKind::Plus, alternatives)
+        );
+    }
+}
+
+void GrammarLoader::parseTerminal(Word& sequence) {
+    char quote = _text[_position++];
+    for (;;) {
+        if (atEnd() || _text[_position] == '\n') {
+            fail("Unterminated terminal");
+        }
+        char character = _text[_position++];
+        if (character == quote) {
+            return;
+        }
+        if (character == '\\') {
+            if (atEnd()) {
+                fail("Unterminated terminal");
+            }
+            character = _text[_position++];
+            if (character == 'n') {
+                character = '\n';
+            } else if (character == 't') {
+                character = '\t';
+            } else if (character == 'r') {
+                character = '\r';
+            }
+        }
+        sequence.emplace_back(character);
+        _usedCharacters[static_cast<unsigned char>(character)] = true;
+    }
+}
+
+Symbol GrammarLoader::addNonterminal(std::string_view name) {
+    auto nonterminal = _nonterminalsByName.find(name);
+    if (nonterminal != _nonterminalsByName.end()) {
+        return nonterminal->second;
+    }
+
+    Symbol symbol = static_cast<int>(firstNonterminal + _names.size());
+    _nonterminalsByName.emplace(_names.emplace_back(name), symbol);
+    _firstUseLines.push_back(_line);
+    _isDefined.push_back(false);
+    _nonterminals.insert(symbol);
+    return symbol;
+}
+
+Symbol GrammarLoader::addHelper(HelperKind kind, Alternatives const& alternatives) {
+    std::string key(1, static_cast<char>(kind));
+    for (auto const& alternative: alternatives) {
+        auto size = static_cast<int>(alternative.size());
+        key.append(reinterpret_cast<char const*>(&size), sizeof(size));
+        key.append(
+            reinterpret_cast<char const*>(alternative.data()),
+            alternative.size() * sizeof(Symbol)
+        );
+    }
+    auto [helper, isInserted] = _helpers.emplace(std::move(key), 0);
+    if (!isInserted) {
+        return helper->second;
+    }
+
+    Symbol nonterminal = static_cast<int>(firstNonterminal + _names.size());
+    helper->second = nonterminal;
+    _names.emplace_back();
+    _firstUseLines.push_back(_line);
+    _isDefined.push_back(true);
+    _nonterminals.insert(nonterminal);
+    ++_helperCount;
+
+    for (auto const& alternative: alternatives) {
+        if (kind == HelperKind::Choice) {
+            _rules.emplace_back(Word{nonterminal}, alternative);
+            continue;
+        }
+        auto rhs = alternative;
+        rhs.push_back(nonterminal);
+        _rules.emplace_back(Word{nonterminal}, rhs);
+        if (kind == HelperKind::Plus) {
+            _rules.emplace_back(Word{nonterminal}, alternative);
+        }
+    }
+    if (kind == HelperKind::Star) {
+        _rules.emplace_back(Word{nonterminal}, emptyWord);
+    }
+    return nonterminal;
+}
+
+void GrammarLoader::fail(char const* reason) const {
+    throw GrammarFormatException(reason, _line);
+}
+
+GrammarFormatException::GrammarFormatException(char const* reason, size_t line):
+    line(line),
+    message(line ? "Line " + std::to_string(line) + ": " + reason : reason)
+{}
+
+char const* GrammarFormatException::what() const throw() {
+    return message.c_str();
+}
+
+char const* UnknownNonterminalException::what() const throw() {
+    return "Grammar has no nonterminal with this name";
+}
+
+}
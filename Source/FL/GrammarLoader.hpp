@@ -0,0 +1,88 @@
+#pragma once
+
+#include "ContextFreeGrammar.hpp"
+#include <bitset>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <exception>
+
+namespace FL {
+
+class GrammarLoader {
+public:
+    static constexpr int firstNonterminal = 256;
+
+    explicit GrammarLoader(std::string_view text);
+    GrammarLoader(GrammarLoader const&) = delete;
+    GrammarLoader(GrammarLoader&&) = default;
+
+    GrammarLoader& operator=(GrammarLoader const&) = delete;
+    GrammarLoader& operator=(GrammarLoader&&) = default;
+
+    static GrammarLoader load(std::string const& path);
+
+    ContextFreeGrammar grammar() const;
+    Alphabet const& terminals() const;
+    Alphabet const& nonterminals() const;
+    Symbol startSymbol() const;
+    std::vector<Grammar::Rule> const& rules() const;
+    size_t helperCount() const;
+    bool hasNonterminal(std::string_view name) const;
+    Symbol nonterminal(std::string_view name) const;
+    std::string const& nonterminalName(Symbol nonterminal) const;
+
+protected:
+    using Alternatives = std::vector<Word>;
+
+    enum class HelperKind: char {
+        Choice,
+        Star,
+        Plus
+    };
+
+    bool atEnd() const;
+    void skipSpace();
+    bool nameStartsAt(size_t position) const;
+    std::string_view parseName();
+    void parseRule();
+    void parseSequence(Word& sequence);
+    Alternatives parseAlternatives(char closing);
+    void parseItem(Word& sequence);
+    void parseTerminal(Word& sequence);
+    Symbol addNonterminal(std::string_view name);
+    Symbol addHelper(HelperKind kind, Alternatives const& alternatives);
+    [[noreturn]] void fail(char const* reason) const;
+
+    std::string_view _text;
+    size_t _position;
+    size_t _line;
+    std::deque<std::string> _names;
+    std::unordered_map<std::string_view, Symbol> _nonterminalsByName;
+    std::unordered_map<std::string, Symbol> _helpers;
+    std::bitset<256> _usedCharacters;
+    std::vector<size_t> _firstUseLines;
+    std::vector<bool> _isDefined;
+    Alphabet _terminals;
+    Alphabet _nonterminals;
+    Symbol _startSymbol;
+    std::vector<Grammar::Rule> _rules;
+    size_t _helperCount;
+};
+
+struct GrammarFormatException: std::exception {
+    GrammarFormatException(char const* reason, size_t line);
+
+    char const* what() const throw();
+
+    size_t line;
+    std::string message;
+};
+
+struct UnknownNonterminalException: std::exception {
+    char const* what() const throw();
+};
+
+}
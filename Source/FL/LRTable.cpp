@@ -0,0 +1,522 @@
+#include "LRTable.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+
+namespace FL {
+
+namespace {
+
+constexpr size_t noIndex = std::numeric_limits<size_t>::max();
+constexpr std::uint32_t noTerminal = std::numeric_limits<std::uint32_t>::max();
+constexpr int minCharacter = std::numeric_limits<signed char>::min();
+constexpr int characterRange = 384;
+
+bool hasBit(std::vector<std::uint64_t> const& bits, size_t index) {
+    return (bits[index / 64] >> (index % 64)) & 1;
+}
+
+void setBit(std::vector<std::uint64_t>& bits, size_t index) {
+    bits[index / 64] |= std::uint64_t(1) << (index % 64);
+}
+
+void clearBit(std::vector<std::uint64_t>& bits, size_t index) {
+    bits[index / 64] &= ~(std::uint64_t(1) << (index % 64));
+}
+
+bool addBits(std::vector<std::uint64_t>& target, std::vector<std::uint64_t> const& source) {
+    bool isChanged = false;
+    for (size_t i = 0; i < target.size(); ++i) {
+        auto bits = target[i] | source[i];
+        isChanged |= bits != target[i];
+        target[i] = bits;
+    }
+    return isChanged;
+}
+
+std::int32_t mostFrequentValue(
+    std::vector<std::int32_t> const& values,
+    std::int32_t excluded,
+    std::int32_t fallback
+) {
+    std::map<std::int32_t, size_t> counts;
+    for (auto value: values) {
+        if (value != excluded) {
+            ++counts[value];
+        }
+    }
+    auto best = fallback;
+    size_t bestCount = 0;
+    for (auto const& [value, count]: counts) {
+        if (count > bestCount) {
+            best = value;
+            bestCount = count;
+        }
+    }
+    return best;
+}
+
+}
+
+bool LRTable::Item::operator<(Item const& item) const {
+    return rule < item.rule || (rule == item.rule && dot < item.dot);
+}
+
+bool LRTable::Item::operator==(Item const& item) const {
+    return rule == item.rule && dot == item.dot;
+}
+
+void LRTable::CompressedTable::build(
+    std::vector<std::vector<std::pair<size_t, std::int32_t>>> const& rows,
+    std::vector<std::int32_t> const& defaults
+) {
+    _values.clear();
+    _checks.clear();
+    _rowOffsets.assign(rows.size(), 0);
+    _defaults = defaults;
+
+    std::vector<size_t> order(rows.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&rows](size_t lhs, size_t rhs) {
+        return rows[lhs].size() > rows[rhs].size();
+    });
+
+    size_t firstFree = 0;
+    for (auto row: order) {
+        auto const& entries = rows[row];
+        if (entries.empty()) {
+            continue;
+        }
+
+        auto firstColumn = entries.front().first;
+        auto offset = firstFree > firstColumn ? firstFree - firstColumn : 0;
+        for (;; ++offset) {
+            auto fits = std::all_of(entries.begin(), entries.end(), [&](auto const& entry) {
+                auto index = offset + entry.first;
+                return index >= _checks.size() || _checks[index] < 0;
+            });
+            if (fits) {
+                break;
+            }
+        }
+
+        auto end = offset + entries.back().first + 1;
+        if (end > _checks.size()) {
+            _values.resize(end, 0);
+            _checks.resize(end, -1);
+        }
+        for (auto const& [column, value]: entries) {
+            _values[offset + column] = value;
+            _checks[offset + column] = static_cast<std::int32_t>(row);
+        }
+        _rowOffsets[row] = offset;
+        while (firstFree < _checks.size() && _checks[firstFree] >= 0) {
+            ++firstFree;
+        }
+    }
+}
+
+std::int32_t LRTable::CompressedTable::get(size_t row, size_t column) const {
+    auto index = _rowOffsets[row] + column;
+    if (index < _checks.size() && _checks[index] == static_cast<std::int32_t>(row)) {
+        return _values[index];
+    }
+    return _defaults[row];
+}
+
+size_t LRTable::CompressedTable::size() const {
+    return _values.size() + _defaults.size();
+}
+
+LRTable::LRTable(ContextFreeGrammar const& grammar) {
+    encodeGrammar(grammar);
+    findFirstSets();
+    buildStates();
+    findLookaheads();
+    buildTables();
+}
+
+bool LRTable::isDeterministic() const {
+    return _conflicts.empty();
+}
+
+std::vector<LRConflict> const& LRTable::conflicts() const {
+    return _conflicts;
+}
+
+size_t LRTable::stateCount() const {
+    return _states.size();
+}
+
+size_t LRTable::denseSize() const {
+    return _states.size() * (_terminalCount + _rulesByLhs.size());
+}
+
+size_t LRTable::compressedSize() const {
+    return _actions.size() + _gotos.size();
+}
+
+bool LRTable::predict(SymbolSequence const& word) const {
+    std::vector<std::uint32_t> stack;
+    return predict(word, stack);
+}
+
+bool LRTable::predict(SymbolSequence const& word, std::vector<std::uint32_t>& stack) const {
+    stack.assign(1, 0);
+    size_t position = 0;
+    auto lookahead = word.empty() ? _endMarker : terminalIndex(word[0]);
+    for (;;) {
+        if (lookahead == noIndex) {
+            return false;
+        }
+
+        auto action = _actions.get(stack.back(), lookahead);
+        if (action > 0) {
+            stack.push_back(static_cast<std::uint32_t>(action - 1));
+            ++position;
+            lookahead = position < word.size() ? terminalIndex(word[position]) : _endMarker;
+        } else if (action < 0) {
+            auto rule = static_cast<size_t>(-action - 1);
+            if (rule == 0) {
+                return true;
+            }
+            stack.resize(stack.size() - _ruleSymbols[rule].size());
+            stack.push_back(static_cast<std::uint32_t>(_gotos.get(stack.back(), _ruleLhs[rule])));
+        } else {
+            return false;
+        }
+    }
+}
+
+LRTable::Lookaheads LRTable::emptyLookaheads() const {
+    return Lookaheads((_propagationMarker + 64) / 64, 0);
+}
+
+bool LRTable::symbolIsTerminal(size_t symbol) const {
+    return symbol < _terminalCount;
+}
+
+size_t LRTable::terminalIndex(Symbol symbol) const {
+    auto character = symbol.rawValue - minCharacter;
+    if (character >= 0 && character < characterRange) {
+        auto index = _characterTerminalIndices[character];
+        return index == noTerminal ? noIndex : index;
+    }
+    auto iterator = _terminalIndices.find(symbol);
+    return iterator == _terminalIndices.end() ? noIndex : iterator->second;
+}
+
+void LRTable::encodeGrammar(ContextFreeGrammar const& grammar) {
+    auto byRawValue = [](Symbol lhs, Symbol rhs) {
+        return lhs.rawValue < rhs.rawValue;
+    };
+
+    _terminals.assign(grammar.terminals().begin(), grammar.terminals().end());
+    std::sort(_terminals.begin(), _terminals.end(), byRawValue);
+    _characterTerminalIndices.assign(characterRange, noTerminal);
+    for (size_t i = 0; i < _terminals.size(); ++i) {
+        _terminalIndices[_terminals[i]] = i;
+        auto character = _terminals[i].rawValue - minCharacter;
+        if (character >= 0 && character < characterRange) {
+            _characterTerminalIndices[character] = static_cast<std::uint32_t>(i);
+        }
+    }
+    _endMarker = _terminals.size();
+    _terminalCount = _endMarker + 1;
+    _propagationMarker = _terminalCount;
+
+    std::vector<Symbol> nonterminals(grammar.nonterminals().begin(), grammar.nonterminals().end());
+    std::sort(nonterminals.begin(), nonterminals.end(), byRawValue);
+    std::unordered_map<Symbol, size_t> nonterminalIndices;
+    for (size_t i = 0; i < nonterminals.size(); ++i) {
+        nonterminalIndices[nonterminals[i]] = i;
+    }
+    auto augmentedStart = nonterminals.size();
+    _rulesByLhs.assign(augmentedStart + 1, {});
+
+    _ruleLhs.push_back(augmentedStart);
+    _ruleSymbols.push_back({_terminalCount + nonterminalIndices.at(grammar.startSymbol())});
+    _rulesByLhs[augmentedStart].push_back(0);
+    for (auto const& [lhs, rhs]: grammar.rules()) {
+        if (lhs.size() != 1 || !nonterminalIndices.count(lhs[0])) {
+            throw NonContextFreeGrammarException();
+        }
+        std::vector<size_t> symbols;
+        for (auto symbol: rhs) {
+            auto nonterminal = nonterminalIndices.find(symbol);
+            symbols.push_back(
+                nonterminal == nonterminalIndices.end() ?
+                    _terminalIndices.at(symbol) :
+                    _terminalCount + nonterminal->second
+            );
+        }
+        _rulesByLhs[nonterminalIndices.at(lhs[0])].push_back(_ruleLhs.size());
+        _ruleLhs.push_back(nonterminalIndices.at(lhs[0]));
+        _ruleSymbols.push_back(std::move(symbols));
+    }
+}
+
+void LRTable::findFirstSets() {
+    _isNullable.assign(_rulesByLhs.size(), false);
+    _firstSets.assign(_rulesByLhs.size(), emptyLookaheads());
+    for (bool isChanged = true; isChanged;) {
+        isChanged = false;
+        for (size_t rule = 0; rule < _ruleSymbols.size(); ++rule) {
+            auto lhs = _ruleLhs[rule];
+            auto firstSet = _firstSets[lhs];
+            auto isNullable = addFirstSet(_ruleSymbols[rule], 0, firstSet);
+            if (firstSet != _firstSets[lhs]) {
+                _firstSets[lhs].swap(firstSet);
+                isChanged = true;
+            }
+            if (isNullable && !_isNullable[lhs]) {
+                _isNullable[lhs] = true;
+                isChanged = true;
+            }
+        }
+    }
+}
+
+bool LRTable::addFirstSet(
+    std::vector<size_t> const& symbols,
+    size_t start,
+    Lookaheads& lookaheads
+) const {
+    for (auto i = start; i < symbols.size(); ++i) {
+        if (symbolIsTerminal(symbols[i])) {
+            setBit(lookaheads, symbols[i]);
+            return false;
+        }
+        auto nonterminal = symbols[i] - _terminalCount;
+        addBits(lookaheads, _firstSets[nonterminal]);
+        if (!_isNullable[nonterminal]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<LRTable::ClosureItem> LRTable::closure(std::vector<ClosureItem> items) const {
+    std::vector<size_t> addedItems(_ruleSymbols.size(), noIndex);
+    std::vector<size_t> pending;
+    for (size_t i = 0; i < items.size(); ++i) {
+        if (items[i].item.dot == 0) {
+            addedItems[items[i].item.rule] = i;
+        }
+        pending.push_back(i);
+    }
+
+    while (!pending.empty()) {
+        auto index = pending.back();
+        pending.pop_back();
+        auto item = items[index].item;
+        auto const& symbols = _ruleSymbols[item.rule];
+        if (item.dot == symbols.size() || symbolIsTerminal(symbols[item.dot])) {
+            continue;
+        }
+
+        auto lookaheads = emptyLookaheads();
+        if (addFirstSet(symbols, item.dot + 1, lookaheads)) {
+            addBits(lookaheads, items[index].lookaheads);
+        }
+        for (auto rule: _rulesByLhs[symbols[item.dot] - _terminalCount]) {
+            auto& added = addedItems[rule];
+            if (added == noIndex) {
+                added = items.size();
+                items.push_back({{rule, 0}, lookaheads});
+                pending.push_back(added);
+            } else if (addBits(items[added].lookaheads, lookaheads)) {
+                pending.push_back(added);
+            }
+        }
+    }
+    return items;
+}
+
+size_t LRTable::transition(size_t state, size_t symbol) const {
+    auto const& transitions = _states[state].transitions;
+    auto iterator = std::lower_bound(
+        transitions.begin(),
+        transitions.end(),
+        std::pair<size_t, size_t>(symbol, 0)
+    );
+    return iterator != transitions.end() && iterator->first == symbol ? iterator->second : noIndex;
+}
+
+void LRTable::buildStates() {
+    std::map<std::vector<Item>, size_t> stateIndices;
+    _states.push_back({{{0, 0}}, {}, {}});
+    stateIndices[_states[0].kernel] = 0;
+
+    for (size_t state = 0; state < _states.size(); ++state) {
+        std::vector<ClosureItem> items;
+        for (auto const& item: _states[state].kernel) {
+            items.push_back({item, emptyLookaheads()});
+        }
+
+        std::map<size_t, std::vector<Item>> kernels;
+        for (auto const& [item, lookaheads]: closure(std::move(items))) {
+            auto const& symbols = _ruleSymbols[item.rule];
+            if (item.dot < symbols.size()) {
+                kernels[symbols[item.dot]].push_back({item.rule, item.dot + 1});
+            }
+        }
+
+        for (auto& [symbol, kernel]: kernels) {
+            std::sort(kernel.begin(), kernel.end());
+            kernel.erase(std::unique(kernel.begin(), kernel.end()), kernel.end());
+            auto [iterator, isInserted] = stateIndices.emplace(kernel, _states.size());
+            if (isInserted) {
+                _states.push_back({kernel, {}, {}});
+            }
+            _states[state].transitions.emplace_back(symbol, iterator->second);
+        }
+    }
+}
+
+void LRTable::findLookaheads() {
+    for (auto& state: _states) {
+        state.lookaheads.assign(state.kernel.size(), emptyLookaheads());
+    }
+    setBit(_states[0].lookaheads[0], _endMarker);
+
+    std::vector<std::pair<Lookaheads const*, Lookaheads*>> propagations;
+    for (size_t state = 0; state < _states.size(); ++state) {
+        for (size_t i = 0; i < _states[state].kernel.size(); ++i) {
+            auto marker = emptyLookaheads();
+            setBit(marker, _propagationMarker);
+            for (auto& [item, lookaheads]: closure({{_states[state].kernel[i], marker}})) {
+                auto const& symbols = _ruleSymbols[item.rule];
+                if (item.dot == symbols.size()) {
+                    continue;
+                }
+
+                auto& target = _states[transition(state, symbols[item.dot])];
+                auto targetItem = std::lower_bound(
+                    target.kernel.begin(),
+                    target.kernel.end(),
+                    Item{item.rule, item.dot + 1}
+                ) - target.kernel.begin();
+                auto& targetLookaheads = target.lookaheads[targetItem];
+                if (hasBit(lookaheads, _propagationMarker)) {
+                    clearBit(lookaheads, _propagationMarker);
+                    propagations.emplace_back(&_states[state].lookaheads[i], &targetLookaheads);
+                }
+                addBits(targetLookaheads, lookaheads);
+            }
+        }
+    }
+
+    for (bool isChanged = true; isChanged;) {
+        isChanged = false;
+        for (auto const& [source, target]: propagations) {
+            isChanged |= addBits(*target, *source);
+        }
+    }
+}
+
+void LRTable::buildTables() {
+    auto nonterminalCount = _rulesByLhs.size();
+    std::vector<std::vector<std::pair<size_t, std::int32_t>>> actionRows(_states.size());
+    std::vector<std::vector<std::pair<size_t, std::int32_t>>> gotoRows(_states.size());
+    std::vector<std::int32_t> actionDefaults(_states.size(), 0);
+    std::vector<std::int32_t> gotoDefaults(_states.size(), 0);
+    std::vector<std::int32_t> actions(_terminalCount);
+    std::vector<std::int32_t> gotos(nonterminalCount);
+
+    for (size_t state = 0; state < _states.size(); ++state) {
+        std::fill(actions.begin(), actions.end(), 0);
+        std::fill(gotos.begin(), gotos.end(), -1);
+        for (auto [symbol, target]: _states[state].transitions) {
+            if (symbolIsTerminal(symbol)) {
+                actions[symbol] = static_cast<std::int32_t>(target + 1);
+            } else {
+                gotos[symbol - _terminalCount] = static_cast<std::int32_t>(target);
+            }
+        }
+
+        std::vector<ClosureItem> items;
+        for (size_t i = 0; i < _states[state].kernel.size(); ++i) {
+            items.push_back({_states[state].kernel[i], _states[state].lookaheads[i]});
+        }
+        for (auto const& [item, lookaheads]: closure(std::move(items))) {
+            if (item.dot != _ruleSymbols[item.rule].size()) {
+                continue;
+            }
+            auto reduction = -static_cast<std::int32_t>(item.rule + 1);
+            for (size_t terminal = 0; terminal < _terminalCount; ++terminal) {
+                if (!hasBit(lookaheads, terminal)) {
+                    continue;
+                }
+                auto& action = actions[terminal];
+                if (action == 0 || action == reduction) {
+                    action = reduction;
+                    continue;
+                }
+
+                LRConflict conflict{
+                    state,
+                    terminal == _endMarker ? Symbol(0) : _terminals[terminal],
+                    terminal == _endMarker,
+                    action > 0 ? LRConflictType::ShiftReduce : LRConflictType::ReduceReduce,
+                    item.rule - 1
+                };
+                if (action < 0) {
+                    conflict.rule = std::max<size_t>(item.rule, -action - 1) - 1;
+                    action = std::max(action, reduction);
+                }
+                _conflicts.push_back(conflict);
+            }
+        }
+
+        std::vector<std::int32_t> reductions;
+        std::copy_if(actions.begin(), actions.end(), std::back_inserter(reductions), [](auto action) {
+            return action < -1;
+        });
+        actionDefaults[state] = mostFrequentValue(reductions, 0, 0);
+        for (size_t terminal = 0; terminal < _terminalCount; ++terminal) {
+            if (actions[terminal] != 0 && actions[terminal] != actionDefaults[state]) {
+                actionRows[state].emplace_back(terminal, actions[terminal]);
+            }
+        }
+
+        gotoDefaults[state] = mostFrequentValue(gotos, -1, 0);
+        for (size_t nonterminal = 0; nonterminal < nonterminalCount; ++nonterminal) {
+            if (gotos[nonterminal] >= 0 && gotos[nonterminal] != gotoDefaults[state]) {
+                gotoRows[state].emplace_back(nonterminal, gotos[nonterminal]);
+            }
+        }
+    }
+
+    _actions.build(actionRows, actionDefaults);
+    _gotos.build(gotoRows, gotoDefaults);
+}
+
+LRRecognizer::LRRecognizer(ContextFreeGrammar const& grammar, CYKOptions const& options):
+    _table(grammar)
+{
+    if (!_table.isDeterministic()) {
+        _fallback = std::make_unique<CYK>(grammar, options);
+    }
+}
+
+LRTable const& LRRecognizer::table() const {
+    return _table;
+}
+
+bool LRRecognizer::isDeterministic() const {
+    return _table.isDeterministic();
+}
+
+std::vector<LRConflict> const& LRRecognizer::conflicts() const {
+    return _table.conflicts();
+}
+
+bool LRRecognizer::predict(SymbolSequence const& word) const {
+    return _fallback ? _fallback->predict(word) : _table.predict(word);
+}
+
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "ContextFreeGrammar.hpp"
+#include "CYK.hpp"
+#include "SymbolSequence.hpp"
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+
+namespace FL {
+
+enum class LRConflictType {
+    ShiftReduce,
+    ReduceReduce
+};
+
+struct LRConflict {
+    size_t state;
+    Symbol lookahead;
+    bool isAtEndOfInput;
+    LRConflictType type;
+    size_t rule;
+};
+
+class LRTable {
+public:
+    explicit LRTable(ContextFreeGrammar const& grammar);
+
+    bool isDeterministic() const;
+    std::vector<LRConflict> const& conflicts() const;
+    size_t stateCount() const;
+    size_t denseSize() const;
+    size_t compressedSize() const;
+    bool predict(SymbolSequence const& word) const;
+    bool predict(SymbolSequence const& word, std::vector<std::uint32_t>& stack) const;
+
+protected:
+    using Lookaheads = std::vector<std::uint64_t>;
+
+    struct Item {
+        size_t rule;
+        size_t dot;
+
+        bool operator<(Item const& item) const;
+        bool operator==(Item const& item) const;
+    };
+
+    struct State {
+        std::vector<Item> kernel;
+        std::vector<Lookaheads> lookaheads;
+        std::vector<std::pair<size_t, size_t>> transitions;
+    };
+
+    struct ClosureItem {
+        Item item;
+        Lookaheads lookaheads;
+    };
+
+    class CompressedTable {
+    public:
+        void build(
+            std::vector<std::vector<std::pair<size_t, std::int32_t>>> const& rows,
+            std::vector<std::int32_t> const& defaults
+        );
+        std::int32_t get(size_t row, size_t column) const;
+        size_t size() const;
+
+    protected:
+        std::vector<std::int32_t> _values;
+        std::vector<std::int32_t> _checks;
+        std::vector<size_t> _rowOffsets;
+        std::vector<std::int32_t> _defaults;
+    };
+
+    Lookaheads emptyLookaheads() const;
+    bool symbolIsTerminal(size_t symbol) const;
+    size_t terminalIndex(Symbol symbol) const;
+    void encodeGrammar(ContextFreeGrammar const& grammar);
+    void findFirstSets();
+    bool addFirstSet(
+        std::vector<size_t> const& symbols,
+        size_t start,
+        Lookaheads& lookaheads
+    ) const;
+    std::vector<ClosureItem> closure(std::vector<ClosureItem> items) const;
+    size_t transition(size_t state, size_t symbol) const;
+    void buildStates();
+    void findLookaheads();
+    void buildTables();
+
+    size_t _terminalCount;
+    size_t _endMarker;
+    size_t _propagationMarker;
+    std::vector<Symbol> _terminals;
+    std::unordered_map<Symbol, size_t> _terminalIndices;
+    std::vector<std::uint32_t> _characterTerminalIndices;
+    std::vector<size_t> _ruleLhs;
+    std::vector<std::vector<size_t>> _ruleSymbols;
+    std::vector<std::vector<size_t>> _rulesByLhs;
+    std::vector<bool> _isNullable;
+    std::vector<Lookaheads> _firstSets;
+    std::vector<State> _states;
+    std::vector<LRConflict> _conflicts;
+    CompressedTable _actions;
+    CompressedTable _gotos;
+};
+
+class LRRecognizer {
+public:
+    explicit LRRecognizer(ContextFreeGrammar const& grammar, CYKOptions const& options = {});
+
+    LRTable const& table() const;
+    bool isDeterministic() const;
+    std::vector<LRConflict> const& conflicts() const;
+    bool predict(SymbolSequence const& word) const;
+
+protected:
+    LRTable _table;
+    std::unique_ptr<CYK> _fallback;
+};
+
+}
@@ -0,0 +1,74 @@
+#include "LatencyHistogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace FL {
+
+void LatencyHistogram::record(std::uint64_t nanoseconds) {
+    ++_counts[bucketIndex(nanoseconds)];
+    ++_count;
+    _sum += nanoseconds;
+    _max = std::max(_max, nanoseconds);
+}
+
+void LatencyHistogram::merge(LatencyHistogram const& histogram) {
+    for (size_t i = 0; i < bucketCount; ++i) {
+        _counts[i] += histogram._counts[i];
+    }
+    _count += histogram._count;
+    _sum += histogram._sum;
+    _max = std::max(_max, histogram._max);
+}
+
+void LatencyHistogram::clear() {
+    *this = LatencyHistogram();
+}
+
+size_t LatencyHistogram::count() const {
+    return _count;
+}
+
+std::uint64_t LatencyHistogram::max() const {
+    return _max;
+}
+
+double LatencyHistogram::mean() const {
+    return _count ? static_cast<double>(_sum) / _count : 0;
+}
+
+std::uint64_t LatencyHistogram::percentile(double fraction) const {
+    if (!_count) {
+        return 0;
+    }
+    auto rank = static_cast<size_t>(std::ceil(std::clamp(fraction, 0.0, 1.0) * _count));
+    rank = std::max<size_t>(rank, 1);
+    size_t seen = 0;
+    for (size_t i = 0; i < bucketCount; ++i) {
+        seen += _counts[i];
+        if (seen >= rank) {
+            return std::min(bucketUpperBound(i), _max);
+        }
+    }
+    return _max;
+}
+
+size_t LatencyHistogram::bucketIndex(std::uint64_t value) {
+    if (value < subBucketCount) {
+        return value;
+    }
+    size_t exponent = 63 - __builtin_clzll(value);
+    size_t subBucket = (value >> (exponent - subBucketBits)) & (subBucketCount - 1);
+    return (exponent - subBucketBits + 1) * subBucketCount + subBucket;
+}
+
+std::uint64_t LatencyHistogram::bucketUpperBound(size_t index) {
+    if (index < subBucketCount) {
+        return index;
+    }
+    size_t shift = index / subBucketCount - 1;
+    std::uint64_t lowerBound = (subBucketCount + index % subBucketCount) << shift;
+    return lowerBound + ((std::uint64_t(1) << shift) - 1);
+}
+
+}
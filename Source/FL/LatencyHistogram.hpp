@@ -0,0 +1,34 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace FL {
+
+class LatencyHistogram {
+public:
+    void record(std::uint64_t nanoseconds);
+    void merge(LatencyHistogram const& histogram);
+    void clear();
+
+    size_t count() const;
+    std::uint64_t max() const;
+    double mean() const;
+    std::uint64_t percentile(double fraction) const;
+
+protected:
+    static constexpr size_t subBucketBits = 4;
+    static constexpr size_t subBucketCount = size_t(1) << subBucketBits;
+    static constexpr size_t bucketCount = (64 - subBucketBits + 1) * subBucketCount;
+
+    static size_t bucketIndex(std::uint64_t value);
+    static std::uint64_t bucketUpperBound(size_t index);
+
+    std::array<std::uint64_t, bucketCount> _counts{};
+    size_t _count = 0;
+    std::uint64_t _sum = 0;
+    std::uint64_t _max = 0;
+};
+
+}
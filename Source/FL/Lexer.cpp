@@ -0,0 +1,321 @@
+#include "Lexer.hpp"
+
+#include <algorithm>
+#include <map>
+
+namespace FL {
+
+Lexer::Lexer(std::vector<TokenDefinition> const& definitions):
+    _definitions(definitions)
+{
+    buildNFA();
+    buildDFA();
+    _nfa.clear();
+    _nfa.shrink_to_fit();
+    _nfaAcceptedDefinitions.clear();
+    _nfaAcceptedDefinitions.shrink_to_fit();
+}
+
+std::vector<TokenDefinition> const& Lexer::definitions() const {
+    return _definitions;
+}
+
+size_t Lexer::stateCount() const {
+    return _acceptedDefinitions.size();
+}
+
+Word Lexer::tokenize(std::string const& text) const {
+    Word word;
+    tokenize(text, word);
+    return word;
+}
+
+void Lexer::tokenize(std::string const& text, Word& word) const {
+    word.clear();
+    for (size_t tokenStart = 0; tokenStart < text.size();) {
+        size_t definition = noDefinition;
+        size_t tokenEnd = tokenStart;
+        std::int32_t state = 0;
+        for (size_t i = tokenStart; i < text.size(); ++i) {
+            state = _transitions[state * alphabetSize + static_cast<unsigned char>(text[i])];
+            if (state < 0) {
+                break;
+            }
+            if (_acceptedDefinitions[state] != noDefinition) {
+                definition = _acceptedDefinitions[state];
+                tokenEnd = i + 1;
+            }
+        }
+
+        if (definition == noDefinition) {
+            throw UnexpectedCharacterException();
+        }
+        if (!_definitions[definition].isSkipped) {
+            word.push_back(_definitions[definition].token);
+        }
+        tokenStart = tokenEnd;
+    }
+}
+
+size_t Lexer::addNFAState() {
+    _nfa.emplace_back();
+    return _nfa.size() - 1;
+}
+
+Lexer::Fragment Lexer::parseAlternation(std::string const& pattern, size_t& position) {
+    auto fragment = parseConcatenation(pattern, position);
+    while (position < pattern.size() && pattern[position] == '|') {
+        ++position;
+        auto alternative = parseConcatenation(pattern, position);
+        Fragment alternation{addNFAState(), addNFAState()};
+        _nfa[alternation.start].epsilonTargets = {fragment.start, alternative.start};
+        _nfa[fragment.end].epsilonTargets.push_back(alternation.end);
+        _nfa[alternative.end].epsilonTargets.push_back(alternation.end);
+        fragment = alternation;
+    }
+    return fragment;
+}
+
+Lexer::Fragment Lexer::parseConcatenation(std::string const& pattern, size_t& position) {
+    auto state = addNFAState();
+    Fragment fragment{state, state};
+    while (position < pattern.size() && pattern[position] != '|' && pattern[position] != ')') {
+        auto next = parseRepetition(pattern, position);
+        _nfa[fragment.end].epsilonTargets.push_back(next.start);
+        fragment.end = next.end;
+    }
+    return fragment;
+}
+
+Lexer::Fragment Lexer::parseRepetition(std::string const& pattern, size_t& position) {
+    auto fragment = parseAtom(pattern, position);
+    while (position < pattern.size()) {
+        char repetition = pattern[position];
+        if (repetition != '*' && repetition != '+' && repetition != '?') {
+            break;
+        }
+        ++position;
+
+        Fragment repeated{addNFAState(), addNFAState()};
+        _nfa[repeated.start].epsilonTargets.push_back(fragment.start);
+        _nfa[fragment.end].epsilonTargets.push_back(repeated.end);
+        if (repetition != '+') {
+            _nfa[repeated.start].epsilonTargets.push_back(repeated.end);
+        }
+        if (repetition != '?') {
+            _nfa[fragment.end].epsilonTargets.push_back(fragment.start);
+        }
+        fragment = repeated;
+    }
+    return fragment;
+}
+
+Lexer::Fragment Lexer::parseAtom(std::string const& pattern, size_t& position) {
+    if (position == pattern.size()) {
+        throw InvalidTokenPatternException();
+    }
+
+    CharacterSet characters;
+    char character = pattern[position++];
+    switch (character) {
+    case '(': {
+        auto fragment = parseAlternation(pattern, position);
+        if (position == pattern.size() || pattern[position] != ')') {
+            throw InvalidTokenPatternException();
+        }
+        ++position;
+        return fragment;
+    }
+    case ')':
+    case '*':
+    case '+':
+    case '?':
+        throw InvalidTokenPatternException();
+    case '[':
+        characters = parseCharacterClass(pattern, position);
+        break;
+    case '.':
+        characters.set();
+        characters.reset('\n');
+        break;
+    case '\\':
+        characters = parseEscape(pattern, position);
+        break;
+    default:
+        characters.set(static_cast<unsigned char>(character));
+    }
+
+    Fragment fragment{addNFAState(), addNFAState()};
+    _nfa[fragment.start].characters = characters;
+    _nfa[fragment.start].target = fragment.end;
+    return fragment;
+}
+
+Lexer::CharacterSet Lexer::parseEscape(std::string const& pattern, size_t& position) const {
+    if (position == pattern.size()) {
+        throw InvalidTokenPatternException();
+    }
+
+    CharacterSet characters;
+    char character = pattern[position++];
+    auto setRange = [&characters](unsigned char first, unsigned char last) {
+        for (size_t i = first; i <= last; ++i) {
+            characters.set(i);
+        }
+    };
+    switch (character) {
+    case 'd':
+        setRange('0', '9');
+        break;
+    case 'w':
+        setRange('0', '9');
+        setRange('a', 'z');
+        setRange('A', 'Z');
+        characters.set('_');
+        break;
+    case 's':
+        for (unsigned char space: std::string(" \t\n\r\f\v")) {
+            characters.set(space);
+        }
+        break;
+    case 'n':
+        characters.set('\n');
+        break;
+    case 't':
+        characters.set('\t');
+        break;
+    case 'r':
+        characters.set('\r');
+        break;
+    default:
+        characters.set(static_cast<unsigned char>(character));
+    }
+    return characters;
+}
+
+Lexer::CharacterSet Lexer::parseCharacterClass(
+    std::string const& pattern,
+    size_t& position
+) const {
+    CharacterSet characters;
+    bool isNegated = position < pattern.size() && pattern[position] == '^';
+    if (isNegated) {
+        ++position;
+    }
+
+    for (;;) {
+        if (position == pattern.size()) {
+            throw InvalidTokenPatternException();
+        }
+        if (pattern[position] == ']') {
+            ++position;
+            break;
+        }
+        if (pattern[position] == '\\') {
+            ++position;
+            characters |= parseEscape(pattern, position);
+            continue;
+        }
+
+        auto first = static_cast<unsigned char>(pattern[position++]);
+        auto last = first;
+        if (
+            position + 1 < pattern.size() &&
+            pattern[position] == '-' &&
+            pattern[position + 1] != ']'
+        ) {
+            last = static_cast<unsigned char>(pattern[position + 1]);
+            position += 2;
+        }
+        for (size_t i = first; i <= last; ++i) {
+            characters.set(i);
+        }
+    }
+
+    return isNegated ? ~characters : characters;
+}
+
+void Lexer::buildNFA() {
+    _nfaStart = addNFAState();
+    std::vector<size_t> acceptingStates;
+    for (auto const& definition: _definitions) {
+        size_t position = 0;
+        auto fragment = parseAlternation(definition.pattern, position);
+        if (position != definition.pattern.size()) {
+            throw InvalidTokenPatternException();
+        }
+        _nfa[_nfaStart].epsilonTargets.push_back(fragment.start);
+        acceptingStates.push_back(fragment.end);
+    }
+
+    _nfaAcceptedDefinitions.assign(_nfa.size(), noDefinition);
+    for (size_t i = 0; i < acceptingStates.size(); ++i) {
+        _nfaAcceptedDefinitions[acceptingStates[i]] = i;
+    }
+}
+
+std::vector<size_t> Lexer::epsilonClosure(std::vector<size_t> states) const {
+    std::vector<bool> isVisited(_nfa.size());
+    for (auto state: states) {
+        isVisited[state] = true;
+    }
+    for (size_t i = 0; i < states.size(); ++i) {
+        for (auto target: _nfa[states[i]].epsilonTargets) {
+            if (!isVisited[target]) {
+                isVisited[target] = true;
+                states.push_back(target);
+            }
+        }
+    }
+
+    std::sort(states.begin(), states.end());
+    return states;
+}
+
+void Lexer::buildDFA() {
+    std::map<std::vector<size_t>, std::int32_t> stateIndices;
+    std::vector<std::vector<size_t>> states{epsilonClosure({_nfaStart})};
+    stateIndices.emplace(states[0], 0);
+
+    for (size_t i = 0; i < states.size(); ++i) {
+        size_t acceptedDefinition = noDefinition;
+        for (auto state: states[i]) {
+            acceptedDefinition = std::min(acceptedDefinition, _nfaAcceptedDefinitions[state]);
+        }
+        _acceptedDefinitions.push_back(acceptedDefinition);
+
+        _transitions.resize((i + 1) * alphabetSize, -1);
+        for (size_t character = 0; character < alphabetSize; ++character) {
+            std::vector<size_t> targets;
+            for (auto state: states[i]) {
+                if (_nfa[state].target != noState && _nfa[state].characters[character]) {
+                    targets.push_back(_nfa[state].target);
+                }
+            }
+            if (targets.empty()) {
+                continue;
+            }
+
+            auto closure = epsilonClosure(std::move(targets));
+            auto [stateIndex, isInserted] = stateIndices.emplace(closure, states.size());
+            if (isInserted) {
+                states.push_back(std::move(closure));
+            }
+            _transitions[i * alphabetSize + character] = stateIndex->second;
+        }
+    }
+
+    if (_acceptedDefinitions[0] != noDefinition) {
+        throw InvalidTokenPatternException();
+    }
+}
+
+char const* InvalidTokenPatternException::what() const throw() {
+    return "Token pattern is invalid or matches the empty string";
+}
+
+char const* UnexpectedCharacterException::what() const throw() {
+    return "Text contains a character that does not start any token";
+}
+
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "Common.hpp"
+#include <bitset>
+#include <string>
+#include <vector>
+#include <limits>
+#include <exception>
+#include <cstdint>
+
+namespace FL {
+
+struct TokenDefinition {
+    std::string pattern;
+    Symbol token;
+    bool isSkipped = false;
+};
+
+class Lexer {
+public:
+    explicit Lexer(std::vector<TokenDefinition> const& definitions);
+
+    std::vector<TokenDefinition> const& definitions() const;
+    size_t stateCount() const;
+    Word tokenize(std::string const& text) const;
+    void tokenize(std::string const& text, Word& word) const;
+
+protected:
+    static constexpr size_t noDefinition = std::numeric_limits<size_t>::max();
+    static constexpr size_t noState = std::numeric_limits<size_t>::max();
+    static constexpr size_t alphabetSize = 256;
+
+    using CharacterSet = std::bitset<alphabetSize>;
+
+    struct NFAState {
+        CharacterSet characters;
+        size_t target = noState;
+        std::vector<size_t> epsilonTargets;
+    };
+
+    struct Fragment {
+        size_t start;
+        size_t end;
+    };
+
+    size_t addNFAState();
+    Fragment parseAlternation(std::string const& pattern, size_t& position);
+    Fragment parseConcatenation(std::string const& pattern, size_t& position);
+    Fragment parseRepetition(std::string const& pattern, size_t& position);
+    Fragment parseAtom(std::string const& pattern, size_t& position);
+    CharacterSet parseEscape(std::string const& pattern, size_t& position) const;
+    CharacterSet parseCharacterClass(std::string const& pattern, size_t& position) const;
+    void buildNFA();
+    std::vector<size_t> epsilonClosure(std::vector<size_t> states) const;
+    void buildDFA();
+
+    std::vector<TokenDefinition> _definitions;
+    std::vector<NFAState> _nfa;
+    std::vector<size_t> _nfaAcceptedDefinitions;
+    size_t _nfaStart;
+    std::vector<std::int32_t> _transitions;
+    std::vector<size_t> _acceptedDefinitions;
+};
+
+struct InvalidTokenPatternException: std::exception {
+    char const* what() const throw();
+};
+
+struct UnexpectedCharacterException: std::exception {
+    char const* what() const throw();
+};
+
+}
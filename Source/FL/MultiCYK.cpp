@@ -0,0 +1,189 @@
+#include "MultiCYK.hpp"
+
+#include <algorithm>
+#include <array>
+#include <map>
+
+namespace FL {
+
+namespace {
+
+using NodeRule = std::array<std::int64_t, 3>;
+
+constexpr std::int64_t emptyRule = 0;
+constexpr std::int64_t terminalRule = 1;
+constexpr std::int64_t binaryRule = 2;
+
+std::vector<NodeRule> classifyRules(
+    std::vector<NodeRule> rules,
+    std::vector<size_t> const& classes
+) {
+    for (auto& rule: rules) {
+        if (rule[0] == binaryRule) {
+            rule[1] = classes[rule[1]];
+            rule[2] = classes[rule[2]];
+        }
+    }
+    std::sort(rules.begin(), rules.end());
+    rules.erase(std::unique(rules.begin(), rules.end()), rules.end());
+    return rules;
+}
+
+}
+
+MultiCYK::MultiCYK(std::vector<ContextFreeGrammar> const& grammars, CYKOptions const& options):
+    MultiCYK(mergeGrammars(grammars), options)
+{}
+
+MultiCYK::MultiCYK(MergedGrammar const& mergedGrammar, CYKOptions const& options):
+    CYK(mergedGrammar.grammar, mergedGrammar.grammar, options),
+    _acceptsEmptyWords(mergedGrammar.acceptsEmptyWord)
+{
+    for (auto startSymbol: mergedGrammar.startSymbols) {
+        _startIndices.push_back(_nonterminalIndices.at(startSymbol));
+    }
+}
+
+size_t MultiCYK::grammarCount() const {
+    return _startIndices.size();
+}
+
+std::vector<size_t> MultiCYK::acceptingGrammars(SymbolSequence const& word) const {
+    thread_local Workspace workspace;
+    return acceptingGrammars(word, workspace);
+}
+
+std::vector<size_t> MultiCYK::acceptingGrammars(
+    SymbolSequence const& word,
+    Workspace& workspace
+) const {
+    std::vector<size_t> grammars;
+    if (word.empty()) {
+        for (size_t i = 0; i < _acceptsEmptyWords.size(); ++i) {
+            if (_acceptsEmptyWords[i]) {
+                grammars.push_back(i);
+            }
+        }
+        return grammars;
+    }
+
+    auto table = calculateTableValues(word, workspace);
+    for (size_t i = 0; i < _startIndices.size(); ++i) {
+        if (table.contains(_startIndices[i], 0, word.size() - 1)) {
+            grammars.push_back(i);
+        }
+    }
+    return grammars;
+}
+
+MultiCYK::MergedGrammar MultiCYK::mergeGrammars(std::vector<ContextFreeGrammar> const& grammars) {
+    Alphabet terminals;
+    int maxTerminal = 0;
+    std::vector<std::vector<NodeRule>> nodeRules;
+    std::vector<size_t> startNodes;
+    for (auto const& sourceGrammar: grammars) {
+        auto grammar = sourceGrammar.normalized();
+        std::vector<Symbol> nonterminals(
+            grammar.nonterminals().begin(),
+            grammar.nonterminals().end()
+        );
+        std::sort(nonterminals.begin(), nonterminals.end(), [](Symbol lhs, Symbol rhs) {
+            return lhs.rawValue < rhs.rawValue;
+        });
+        std::unordered_map<Symbol, size_t> nodes;
+        for (auto nonterminal: nonterminals) {
+            nodes[nonterminal] = nodeRules.size();
+            nodeRules.emplace_back();
+        }
+        startNodes.push_back(nodes.at(grammar.startSymbol()));
+
+        for (auto terminal: grammar.terminals()) {
+            terminals.insert(terminal);
+            maxTerminal = std::max(maxTerminal, terminal.rawValue);
+        }
+        for (auto const& [lhs, rhs]: grammar.rules()) {
+            auto& rules = nodeRules[nodes.at(lhs[0])];
+            if (rhs.empty()) {
+                rules.push_back({emptyRule, 0, 0});
+            } else if (rhs.size() == 1) {
+                rules.push_back({terminalRule, rhs[0].rawValue, 0});
+            } else {
+                rules.push_back({
+                    binaryRule,
+                    static_cast<std::int64_t>(nodes.at(rhs[0])),
+                    static_cast<std::int64_t>(nodes.at(rhs[1]))
+                });
+            }
+        }
+    }
+
+    std::vector<size_t> classes(nodeRules.size(), 0);
+    size_t classCount = nodeRules.empty() ? 0 : 1;
+    for (;;) {
+        std::map<std::vector<std::int64_t>, size_t> signatures;
+        std::vector<size_t> nextClasses(nodeRules.size());
+        std::vector<std::int64_t> signature;
+        for (size_t node = 0; node < nodeRules.size(); ++node) {
+            signature.assign(1, classes[node]);
+            for (auto const& rule: classifyRules(nodeRules[node], classes)) {
+                signature.insert(signature.end(), rule.begin(), rule.end());
+            }
+            nextClasses[node] = signatures.emplace(signature, signatures.size()).first->second;
+        }
+        classes.swap(nextClasses);
+        if (signatures.size() == classCount) {
+            break;
+        }
+        classCount = signatures.size();
+    }
+
+    if (static_cast<std::int64_t>(maxTerminal) + classCount + 1 > Symbol::maxValue) {
+        throw GrammarOutOfSymbolsException();
+    }
+    auto classSymbol = [maxTerminal](size_t nonterminalClass) {
+        return Symbol(static_cast<int>(maxTerminal + 1 + nonterminalClass));
+    };
+
+    Alphabet nonterminals;
+    std::vector<Grammar::Rule> rules;
+    std::vector<bool> isClassAdded(classCount);
+    for (size_t node = 0; node < nodeRules.size(); ++node) {
+        if (isClassAdded[classes[node]]) {
+            continue;
+        }
+        isClassAdded[classes[node]] = true;
+        auto lhs = classSymbol(classes[node]);
+        nonterminals.insert(lhs);
+        for (auto const& rule: classifyRules(nodeRules[node], classes)) {
+            Word rhs;
+            if (rule[0] == terminalRule) {
+                rhs.emplace_back(static_cast<int>(rule[1]));
+            } else if (rule[0] == binaryRule) {
+                rhs = {classSymbol(rule[1]), classSymbol(rule[2])};
+            }
+            rules.emplace_back(Word{lhs}, rhs);
+        }
+    }
+
+    MergedGrammar mergedGrammar{
+        ContextFreeGrammar(
+            terminals,
+            nonterminals.empty() ? Alphabet{classSymbol(0)} : nonterminals,
+            startNodes.empty() ? classSymbol(0) : classSymbol(classes[startNodes[0]]),
+            rules
+        ),
+        {},
+        {}
+    };
+    for (auto startNode: startNodes) {
+        mergedGrammar.startSymbols.push_back(classSymbol(classes[startNode]));
+        auto const& startRules = nodeRules[startNode];
+        mergedGrammar.acceptsEmptyWord.push_back(
+            std::find(startRules.begin(), startRules.end(), NodeRule{emptyRule, 0, 0}) !=
+                startRules.end()
+        );
+    }
+    return mergedGrammar;
+}
+
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "CYK.hpp"
+#include <vector>
+
+namespace FL {
+
+class MultiCYK: protected CYK {
+public:
+    using CYK::Workspace;
+    using CYK::grammar;
+    using CYK::options;
+
+    explicit MultiCYK(
+        std::vector<ContextFreeGrammar> const& grammars,
+        CYKOptions const& options = {}
+    );
+
+    size_t grammarCount() const;
+    std::vector<size_t> acceptingGrammars(SymbolSequence const& word) const;
+    std::vector<size_t> acceptingGrammars(SymbolSequence const& word, Workspace& workspace) const;
+
+protected:
+    struct MergedGrammar {
+        ContextFreeGrammar grammar;
+        std::vector<Symbol> startSymbols;
+        std::vector<bool> acceptsEmptyWord;
+    };
+
+    MultiCYK(MergedGrammar const& mergedGrammar, CYKOptions const& options);
+
+    static MergedGrammar mergeGrammars(std::vector<ContextFreeGrammar> const& grammars);
+
+    std::vector<size_t> _startIndices;
+    std::vector<bool> _acceptsEmptyWords;
+};
+
+}
@@ -0,0 +1,381 @@
+#include "ParseForest.hpp"
+
+#include <algorithm>
+
+namespace FL {
+
+namespace {
+
+std::uint64_t saturatingAdd(std::uint64_t lhs, std::uint64_t rhs) {
+    return lhs > std::numeric_limits<std::uint64_t>::max() - rhs ?
+        std::numeric_limits<std::uint64_t>::max() : lhs + rhs;
+}
+
+std::uint64_t saturatingMultiply(std::uint64_t lhs, std::uint64_t rhs) {
+    return rhs && lhs > std::numeric_limits<std::uint64_t>::max() / rhs ?
+        std::numeric_limits<std::uint64_t>::max() : lhs * rhs;
+}
+
+std::uint64_t alternativeTreeCount(
+    std::vector<ParseForest::Node> const& nodes,
+    ParseForest::Alternative const& alternative
+) {
+    if (alternative.leftChild == ParseForest::noNode) {
+        return 1;
+    }
+    return saturatingMultiply(
+        nodes[alternative.leftChild].treeCount,
+        nodes[alternative.rightChild].treeCount
+    );
+}
+
+}
+
+ParseForest::Iterator::Iterator(ParseForest const& forest, std::uint64_t index):
+    _forest(&forest),
+    _index(index)
+{}
+
+ParseTree ParseForest::Iterator::operator*() const {
+    return _forest->tree(_index);
+}
+
+ParseForest::Iterator& ParseForest::Iterator::operator++() {
+    ++_index;
+    return *this;
+}
+
+bool ParseForest::Iterator::operator==(Iterator const& iterator) const {
+    return _forest == iterator._forest && _index == iterator._index;
+}
+
+bool ParseForest::Iterator::operator!=(Iterator const& iterator) const {
+    return !(*this == iterator);
+}
+
+ParseForest::ParseForest(
+    std::shared_ptr<ContextFreeGrammar const> sourceGrammar,
+    std::shared_ptr<ContextFreeGrammar const> grammar
+):
+    _sourceGrammar(std::move(sourceGrammar)),
+    _grammar(std::move(grammar)),
+    _root(noNode)
+{
+    for (size_t i = 0; i < _sourceGrammar->rules().size(); ++i) {
+        _sourceRules[_sourceGrammar->rules()[i].lhs[0]].push_back(i);
+    }
+    findEpsilonRules();
+}
+
+bool ParseForest::empty() const {
+    return _root == noNode;
+}
+
+size_t ParseForest::root() const {
+    return _root;
+}
+
+std::vector<ParseForest::Node> const& ParseForest::nodes() const {
+    return _nodes;
+}
+
+std::vector<ParseForest::Alternative> const& ParseForest::alternatives() const {
+    return _alternatives;
+}
+
+std::uint64_t ParseForest::treeCount() const {
+    return empty() ? 0 : _nodes[_root].treeCount;
+}
+
+ParseTree ParseForest::normalizedTree(std::uint64_t index) const {
+    if (index >= treeCount()) {
+        throw ParseTreeNotFoundException();
+    }
+
+    ParseTree tree;
+    tree.root = extractNode(tree, _root, index);
+    return tree;
+}
+
+ParseTree ParseForest::tree(std::uint64_t index) const {
+    auto normalizedTree = this->normalizedTree(index);
+    ParseTree tree;
+    tree.root = restoreItem(tree, normalizedTree, normalizedTree.root).nodes.front();
+    restoreSpans(tree, tree.root, 0);
+    return tree;
+}
+
+ParseForest::Iterator ParseForest::begin() const {
+    return Iterator(*this, 0);
+}
+
+ParseForest::Iterator ParseForest::end() const {
+    return Iterator(*this, treeCount());
+}
+
+size_t ParseForest::addNode(
+    Symbol nonterminal,
+    size_t start,
+    size_t size,
+    std::vector<Alternative> const& alternatives
+) {
+    std::uint64_t treeCount = 0;
+    for (auto const& alternative: alternatives) {
+        treeCount = saturatingAdd(treeCount, alternativeTreeCount(_nodes, alternative));
+    }
+
+    _nodes.push_back({
+        nonterminal,
+        start,
+        size,
+        _alternatives.size(),
+        alternatives.size(),
+        treeCount
+    });
+    _alternatives.insert(_alternatives.end(), alternatives.begin(), alternatives.end());
+    return _nodes.size() - 1;
+}
+
+size_t ParseForest::extractNode(ParseTree& tree, size_t node, std::uint64_t index) const {
+    auto const& forestNode = _nodes[node];
+    size_t alternativesEnd = forestNode.firstAlternative + forestNode.alternativeCount;
+    for (size_t i = forestNode.firstAlternative; i < alternativesEnd; ++i) {
+        auto const& alternative = _alternatives[i];
+        auto treeCount = alternativeTreeCount(_nodes, alternative);
+        if (index >= treeCount && i + 1 < alternativesEnd) {
+            index -= treeCount;
+            continue;
+        }
+
+        size_t treeNode = tree.nodes.size();
+        tree.nodes.push_back({
+            forestNode.nonterminal,
+            alternative.rule,
+            forestNode.start,
+            forestNode.size,
+            {}
+        });
+        if (alternative.leftChild == noNode) {
+            auto const& rhs = _grammar->rules()[alternative.rule].rhs;
+            if (!rhs.empty()) {
+                tree.nodes[treeNode].children.push_back(tree.nodes.size());
+                tree.nodes.push_back({rhs[0], ParseTree::noRule, forestNode.start, 1, {}});
+            }
+        } else {
+            auto leftTreeCount = _nodes[alternative.leftChild].treeCount;
+            auto leftChild = extractNode(tree, alternative.leftChild, index % leftTreeCount);
+            auto rightChild = extractNode(tree, alternative.rightChild, index / leftTreeCount);
+            tree.nodes[treeNode].children = {leftChild, rightChild};
+        }
+        return treeNode;
+    }
+
+    return noNode;
+}
+
+void ParseForest::findEpsilonRules() {
+    auto const& rules = _sourceGrammar->rules();
+    for (bool foundNewRules = true; foundNewRules;) {
+        foundNewRules = false;
+        for (size_t i = 0; i < rules.size(); ++i) {
+            auto const& [lhs, rhs] = rules[i];
+            if (_epsilonRules.count(lhs[0])) {
+                continue;
+            }
+            bool isEpsilonRule = std::all_of(rhs.begin(), rhs.end(), [this](Symbol symbol) {
+                return _epsilonRules.count(symbol) != 0;
+            });
+            if (isEpsilonRule) {
+                _epsilonRules.emplace(lhs[0], i);
+                foundNewRules = true;
+            }
+        }
+    }
+}
+
+size_t ParseForest::restoreEpsilonNode(ParseTree& tree, Symbol nonterminal) const {
+    auto rule = _epsilonRules.at(nonterminal);
+    std::vector<size_t> children;
+    for (auto symbol: _sourceGrammar->rules()[rule].rhs) {
+        children.push_back(restoreEpsilonNode(tree, symbol));
+    }
+
+    tree.nodes.push_back({nonterminal, rule, 0, 0, std::move(children)});
+    return tree.nodes.size() - 1;
+}
+
+ParseForest::Item ParseForest::restoreItem(
+    ParseTree& tree,
+    ParseTree const& normalizedTree,
+    size_t node
+) const {
+    auto const& normalizedNode = normalizedTree.nodes[node];
+    if (normalizedNode.rule == ParseTree::noRule) {
+        tree.nodes.push_back(normalizedNode);
+        return {normalizedNode.symbol, nullptr, {tree.nodes.size() - 1}};
+    }
+
+    std::vector<Item> items;
+    for (auto child: normalizedNode.children) {
+        items.push_back(restoreItem(tree, normalizedTree, child));
+    }
+
+    std::vector<Symbol> chain;
+    auto const& auxiliaryNonterminals = _grammar->auxiliaryNonterminals();
+    auto sequence = auxiliaryNonterminals.find(normalizedNode.symbol);
+    if (_sourceGrammar->symbolIsNonterminal(normalizedNode.symbol)) {
+        size_t restoredNode;
+        if (restoreNode(tree, normalizedNode.symbol, items, chain, restoredNode)) {
+            return {normalizedNode.symbol, nullptr, {restoredNode}};
+        }
+    } else if (sequence != auxiliaryNonterminals.end()) {
+        std::vector<size_t> restoredNodes;
+        if (
+            restoreSequence(tree, sequence->second, items, chain, false, restoredNodes) ||
+            restoreSequence(tree, sequence->second, items, chain, true, restoredNodes)
+        ) {
+            return {normalizedNode.symbol, &sequence->second, std::move(restoredNodes)};
+        }
+    }
+
+    throw ParseTreeRestorationException();
+}
+
+bool ParseForest::matchSequence(
+    Word const& sequence,
+    std::vector<Item> const& items,
+    size_t position,
+    size_t item,
+    std::vector<size_t>& matchedItems
+) const {
+    if (position == sequence.size()) {
+        return item == items.size();
+    }
+
+    if (item < items.size()) {
+        auto const& [symbol, itemSequence, nodes] = items[item];
+        bool matches = sequence[position] == symbol;
+        if (itemSequence) {
+            matches = (
+                position + itemSequence->size() <= sequence.size() &&
+                std::equal(itemSequence->begin(), itemSequence->end(), sequence.begin() + position)
+            );
+        }
+        if (matches) {
+            matchedItems.push_back(item);
+            size_t nextPosition = position + (itemSequence ? itemSequence->size() : 1);
+            if (matchSequence(sequence, items, nextPosition, item + 1, matchedItems)) {
+                return true;
+            }
+            matchedItems.pop_back();
+        }
+    }
+    if (_epsilonRules.count(sequence[position])) {
+        matchedItems.push_back(noNode);
+        if (matchSequence(sequence, items, position + 1, item, matchedItems)) {
+            return true;
+        }
+        matchedItems.pop_back();
+    }
+    return false;
+}
+
+bool ParseForest::restoreSequence(
+    ParseTree& tree,
+    Word const& sequence,
+    std::vector<Item> const& items,
+    std::vector<Symbol>& chain,
+    bool allowChains,
+    std::vector<size_t>& nodes
+) const {
+    if (!allowChains) {
+        std::vector<size_t> matchedItems;
+        if (!matchSequence(sequence, items, 0, 0, matchedItems)) {
+            return false;
+        }
+        size_t position = 0;
+        for (auto item: matchedItems) {
+            if (item == noNode) {
+                nodes.push_back(restoreEpsilonNode(tree, sequence[position++]));
+            } else {
+                nodes.insert(nodes.end(), items[item].nodes.begin(), items[item].nodes.end());
+                position += items[item].nodes.size();
+            }
+        }
+        return true;
+    }
+
+    for (size_t i = 0; i < sequence.size(); ++i) {
+        if (!_sourceGrammar->symbolIsNonterminal(sequence[i])) {
+            continue;
+        }
+        bool othersAreNullable = true;
+        for (size_t j = 0; j < sequence.size() && othersAreNullable; ++j) {
+            othersAreNullable = j == i || _epsilonRules.count(sequence[j]);
+        }
+        size_t node;
+        if (!othersAreNullable || !restoreNode(tree, sequence[i], items, chain, node)) {
+            continue;
+        }
+        for (size_t j = 0; j < sequence.size(); ++j) {
+            nodes.push_back(j == i ? node : restoreEpsilonNode(tree, sequence[j]));
+        }
+        return true;
+    }
+    return false;
+}
+
+bool ParseForest::restoreNode(
+    ParseTree& tree,
+    Symbol nonterminal,
+    std::vector<Item> const& items,
+    std::vector<Symbol>& chain,
+    size_t& node
+) const {
+    auto rules = _sourceRules.find(nonterminal);
+    if (
+        rules == _sourceRules.end() ||
+        std::find(chain.begin(), chain.end(), nonterminal) != chain.end()
+    ) {
+        return false;
+    }
+
+    chain.push_back(nonterminal);
+    for (bool allowChains: {false, true}) {
+        for (auto rule: rules->second) {
+            std::vector<size_t> children;
+            auto const& rhs = _sourceGrammar->rules()[rule].rhs;
+            if (restoreSequence(tree, rhs, items, chain, allowChains, children)) {
+                chain.pop_back();
+                tree.nodes.push_back({nonterminal, rule, 0, 0, std::move(children)});
+                node = tree.nodes.size() - 1;
+                return true;
+            }
+        }
+    }
+    chain.pop_back();
+    return false;
+}
+
+size_t ParseForest::restoreSpans(ParseTree& tree, size_t node, size_t start) const {
+    if (tree.nodes[node].rule == ParseTree::noRule && tree.nodes[node].children.empty()) {
+        return tree.nodes[node].start + tree.nodes[node].size;
+    }
+
+    tree.nodes[node].start = start;
+    for (auto child: tree.nodes[node].children) {
+        start = restoreSpans(tree, child, start);
+    }
+    tree.nodes[node].size = start - tree.nodes[node].start;
+    return start;
+}
+
+char const* ParseTreeNotFoundException::what() const throw() {
+    return "Parse forest has no tree with this index";
+}
+
+char const* ParseTreeRestorationException::what() const throw() {
+    return "Parse tree could not be mapped to a source grammar derivation";
+}
+
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "ContextFreeGrammar.hpp"
+#include <unordered_map>
+#include <vector>
+#include <memory>
+#include <limits>
+#include <iterator>
+#include <cstdint>
+
+namespace FL {
+
+struct ParseTree {
+    static constexpr size_t noRule = std::numeric_limits<size_t>::max();
+
+    struct Node {
+        Symbol symbol;
+        size_t rule;
+        size_t start;
+        size_t size;
+        std::vector<size_t> children;
+    };
+
+    std::vector<Node> nodes;
+    size_t root = 0;
+};
+
+class ParseForest {
+public:
+    static constexpr size_t noNode = std::numeric_limits<size_t>::max();
+
+    struct Node {
+        Symbol nonterminal;
+        size_t start;
+        size_t size;
+        size_t firstAlternative;
+        size_t alternativeCount;
+        std::uint64_t treeCount;
+    };
+
+    struct Alternative {
+        size_t rule;
+        size_t leftChild;
+        size_t rightChild;
+    };
+
+    class Iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = ParseTree;
+        using difference_type = std::ptrdiff_t;
+        using pointer = ParseTree const*;
+        using reference = ParseTree const&;
+
+        Iterator(ParseForest const& forest, std::uint64_t index);
+
+        ParseTree operator*() const;
+        Iterator& operator++();
+        bool operator==(Iterator const& iterator) const;
+        bool operator!=(Iterator const& iterator) const;
+
+    protected:
+        ParseForest const* _forest;
+        std::uint64_t _index;
+    };
+
+    ParseForest(
+        std::shared_ptr<ContextFreeGrammar const> sourceGrammar,
+        std::shared_ptr<ContextFreeGrammar const> grammar
+    );
+
+    bool empty() const;
+    size_t root() const;
+    std::vector<Node> const& nodes() const;
+    std::vector<Alternative> const& alternatives() const;
+    std::uint64_t treeCount() const;
+
+    ParseTree normalizedTree(std::uint64_t index = 0) const;
+    ParseTree tree(std::uint64_t index = 0) const;
+
+    Iterator begin() const;
+    Iterator end() const;
+
+protected:
+    friend class CYK;
+
+    struct Item {
+        Symbol symbol;
+        Word const* sequence;
+        std::vector<size_t> nodes;
+    };
+
+    size_t addNode(
+        Symbol nonterminal,
+        size_t start,
+        size_t size,
+        std::vector<Alternative> const& alternatives
+    );
+    size_t extractNode(ParseTree& tree, size_t node, std::uint64_t index) const;
+
+    void findEpsilonRules();
+    size_t restoreEpsilonNode(ParseTree& tree, Symbol nonterminal) const;
+    Item restoreItem(ParseTree& tree, ParseTree const& normalizedTree, size_t node) const;
+    bool matchSequence(
+        Word const& sequence,
+        std::vector<Item> const& items,
+        size_t position,
+        size_t item,
+        std::vector<size_t>& matchedItems
+    ) const;
+    bool restoreSequence(
+        ParseTree& tree,
+        Word const& sequence,
+        std::vector<Item> const& items,
+        std::vector<Symbol>& chain,
+        bool allowChains,
+        std::vector<size_t>& nodes
+    ) const;
+    bool restoreNode(
+        ParseTree& tree,
+        Symbol nonterminal,
+        std::vector<Item> const& items,
+        std::vector<Symbol>& chain,
+        size_t& node
+    ) const;
+    size_t restoreSpans(ParseTree& tree, size_t node, size_t start) const;
+
+    std::shared_ptr<ContextFreeGrammar const> _sourceGrammar;
+    std::shared_ptr<ContextFreeGrammar const> _grammar;
+    std::vector<Node> _nodes;
+    std::vector<Alternative> _alternatives;
+    size_t _root;
+    std::unordered_map<Symbol, std::vector<size_t>> _sourceRules;
+    std::unordered_map<Symbol, size_t> _epsilonRules;
+};
+
+struct ParseTreeNotFoundException: std::exception {
+    char const* what() const throw();
+};
+
+struct ParseTreeRestorationException: std::exception {
+    char const* what() const throw();
+};
+
+}
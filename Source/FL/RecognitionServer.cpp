@@ -0,0 +1,495 @@
+#include "RecognitionServer.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace FL {
+
+namespace {
+
+constexpr size_t receiveBufferSize = 64 * 1024;
+constexpr size_t clientWindowSize = 256;
+
+bool sendAll(int descriptor, std::string const& data) {
+    for (size_t offset = 0; offset < data.size();) {
+        auto size = ::send(descriptor, data.data() + offset, data.size() - offset, MSG_NOSIGNAL);
+        if (size < 0 && errno == EINTR) {
+            continue;
+        }
+        if (size <= 0) {
+            return false;
+        }
+        offset += size;
+    }
+    return true;
+}
+
+bool makeAddress(std::string const& path, sockaddr_un& address) {
+    address = {};
+    address.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+        return false;
+    }
+    std::memcpy(address.sun_path, path.data(), path.size());
+    return true;
+}
+
+void removeSocket(std::string const& path) {
+    struct stat status;
+    if (lstat(path.c_str(), &status) == 0 && S_ISSOCK(status.st_mode)) {
+        unlink(path.c_str());
+    }
+}
+
+std::string_view nextField(std::string_view& text) {
+    size_t separator = std::min(text.find(' '), text.size());
+    auto field = text.substr(0, separator);
+    text.remove_prefix(std::min(separator + 1, text.size()));
+    return field;
+}
+
+}
+
+RecognitionServer::RecognitionServer(ServerOptions const& options):
+    _options(options),
+    _listenerDescriptor(-1),
+    _isRunning(true),
+    _isDispatching(true),
+    _connectionCount(0),
+    _pool(options.threadCount)
+{
+    _options.maxBatchSize = std::max<size_t>(_options.maxBatchSize, 1);
+
+    sockaddr_un address;
+    if (!makeAddress(_options.socketPath, address)) {
+        throw ServerSocketException();
+    }
+    _listenerDescriptor = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (_listenerDescriptor < 0) {
+        throw ServerSocketException();
+    }
+    removeSocket(_options.socketPath);
+    if (
+        bind(_listenerDescriptor, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(_listenerDescriptor, SOMAXCONN) != 0
+    ) {
+        close(_listenerDescriptor);
+        throw ServerSocketException();
+    }
+
+    _dispatcher = std::thread(&RecognitionServer::dispatch, this);
+}
+
+RecognitionServer::~RecognitionServer() {
+    stop();
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _isDispatching = false;
+    }
+    _condition.notify_all();
+    _dispatcher.join();
+    close(_listenerDescriptor);
+    removeSocket(_options.socketPath);
+}
+
+ServerOptions const& RecognitionServer::options() const {
+    return _options;
+}
+
+void RecognitionServer::addGrammar(std::string const& name, GrammarSource source) {
+    auto cyk = std::make_shared<CYK const>(source());
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto& grammar = _grammars[name];
+    grammar.source = std::move(source);
+    grammar.cyk = std::move(cyk);
+}
+
+void RecognitionServer::reloadGrammar(std::string const& name) {
+    GrammarSource source;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto grammar = _grammars.find(name);
+        if (grammar == _grammars.end()) {
+            throw UnknownGrammarException();
+        }
+        source = grammar->second.source;
+    }
+
+    auto cyk = std::make_shared<CYK const>(source());
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto grammar = _grammars.find(name);
+    if (grammar == _grammars.end()) {
+        throw UnknownGrammarException();
+    }
+    grammar->second.cyk = std::move(cyk);
+}
+
+std::vector<std::string> RecognitionServer::grammarNames() const {
+    std::vector<std::string> names;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (auto const& [name, grammar]: _grammars) {
+            names.push_back(name);
+        }
+    }
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+LatencyHistogram RecognitionServer::latencies(std::string const& name) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto grammar = _grammars.find(name);
+    if (grammar == _grammars.end()) {
+        throw UnknownGrammarException();
+    }
+    return grammar->second.latencies;
+}
+
+std::future<bool> RecognitionServer::check(std::string const& name, std::string_view word) {
+    auto request = std::make_unique<Request>();
+    request->word = word;
+    request->receiptTime = std::chrono::steady_clock::now();
+    auto result = request->result.get_future();
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto grammar = _grammars.find(name);
+    if (grammar == _grammars.end()) {
+        throw UnknownGrammarException();
+    }
+    auto& queue = grammar->second.queue;
+    queue.push_back(std::move(request));
+    if (queue.size() >= _options.maxBatchSize || !_isDispatching) {
+        dispatchBatch(name, grammar->second);
+    } else if (queue.size() == 1) {
+        _condition.notify_all();
+    }
+    return result;
+}
+
+void RecognitionServer::run() {
+    while (_isRunning) {
+        int descriptor = accept(_listenerDescriptor, nullptr, nullptr);
+        if (descriptor < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            break;
+        }
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_isRunning) {
+            close(descriptor);
+            break;
+        }
+        _connectionDescriptors.insert(descriptor);
+        ++_connectionCount;
+        std::thread(&RecognitionServer::serveConnection, this, descriptor).detach();
+    }
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    for (auto descriptor: _connectionDescriptors) {
+        shutdown(descriptor, SHUT_RDWR);
+    }
+    _connectionsFinished.wait(lock, [this] {
+        return !_connectionCount;
+    });
+}
+
+void RecognitionServer::stop() {
+    _isRunning = false;
+    shutdown(_listenerDescriptor, SHUT_RDWR);
+}
+
+void RecognitionServer::dispatch() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    for (;;) {
+        auto now = std::chrono::steady_clock::now();
+        auto deadline = std::chrono::steady_clock::time_point::max();
+        for (auto& [name, grammar]: _grammars) {
+            if (grammar.queue.empty()) {
+                continue;
+            }
+            auto batchDeadline = grammar.queue.front()->receiptTime + _options.batchDelay;
+            if (batchDeadline <= now || !_isDispatching) {
+                dispatchBatch(name, grammar);
+            } else {
+                deadline = std::min(deadline, batchDeadline);
+            }
+        }
+
+        if (!_isDispatching) {
+            return;
+        }
+        if (deadline == std::chrono::steady_clock::time_point::max()) {
+            _condition.wait(lock);
+        } else {
+            _condition.wait_until(lock, deadline);
+        }
+    }
+}
+
+void RecognitionServer::dispatchBatch(std::string const& name, GrammarEntry& grammar) {
+    auto batch = std::make_shared<std::vector<std::unique_ptr<Request>>>(
+        std::move(grammar.queue)
+    );
+    grammar.queue.clear();
+    _pool.submit([this, name, cyk = grammar.cyk, batch] {
+        recognizeBatch(name, cyk, *batch);
+    });
+}
+
+void RecognitionServer::recognizeBatch(
+    std::string const& name,
+    std::shared_ptr<CYK const> const& cyk,
+    std::vector<std::unique_ptr<Request>>& batch
+) {
+    thread_local CYK::Workspace workspace;
+    LatencyHistogram latencies;
+    std::vector<std::uint8_t> results(batch.size());
+    std::vector<std::exception_ptr> exceptions(batch.size());
+    for (size_t i = 0; i < batch.size(); ++i) {
+        try {
+            results[i] = cyk->predict(batch[i]->word, workspace);
+        } catch (...) {
+            exceptions[i] = std::current_exception();
+        }
+        latencies.record(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - batch[i]->receiptTime
+        ).count());
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto grammar = _grammars.find(name);
+        if (grammar != _grammars.end()) {
+            grammar->second.latencies.merge(latencies);
+        }
+    }
+    for (size_t i = 0; i < batch.size(); ++i) {
+        if (exceptions[i]) {
+            batch[i]->result.set_exception(exceptions[i]);
+        } else {
+            batch[i]->result.set_value(results[i]);
+        }
+    }
+}
+
+void RecognitionServer::serveConnection(int descriptor) {
+    std::string buffer;
+    std::vector<char> data(receiveBufferSize);
+    std::vector<std::pair<std::string, std::future<bool>>> responses;
+    std::string output;
+    for (;;) {
+        auto size = recv(descriptor, data.data(), data.size(), 0);
+        if (size < 0 && errno == EINTR) {
+            continue;
+        }
+        if (size <= 0) {
+            break;
+        }
+        buffer.append(data.data(), size);
+
+        responses.clear();
+        size_t lineStart = 0;
+        for (size_t lineEnd; (lineEnd = buffer.find('\n', lineStart)) != std::string::npos;) {
+            auto request = std::string_view(buffer).substr(lineStart, lineEnd - lineStart);
+            responses.emplace_back();
+            responses.back().first = respond(request, responses.back().second);
+            lineStart = lineEnd + 1;
+        }
+        buffer.erase(0, lineStart);
+
+        output.clear();
+        for (auto& [response, result]: responses) {
+            if (result.valid()) {
+                try {
+                    response = result.get() ? "accept" : "reject";
+                } catch (std::exception const& exception) {
+                    response = std::string("error ") + exception.what();
+                }
+            }
+            output += response;
+            output += '\n';
+        }
+        if (!sendAll(descriptor, output)) {
+            break;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _connectionDescriptors.erase(descriptor);
+    close(descriptor);
+    --_connectionCount;
+    _connectionsFinished.notify_all();
+}
+
+std::string RecognitionServer::respond(std::string_view request, std::future<bool>& result) {
+    if (!request.empty() && request.back() == '\r') {
+        request.remove_suffix(1);
+    }
+    auto command = nextField(request);
+    try {
+        if (command == "CHECK") {
+            auto name = nextField(request);
+            result = check(std::string(name), request);
+            return {};
+        }
+        if (command == "RELOAD") {
+            reloadGrammar(std::string(request));
+            return "ok";
+        }
+        if (command == "STATS") {
+            return statistics();
+        }
+        if (command == "GRAMMARS") {
+            std::string response;
+            for (auto const& name: grammarNames()) {
+                response += response.empty() ? name : ' ' + name;
+            }
+            return response;
+        }
+    } catch (std::exception const& exception) {
+        return std::string("error ") + exception.what();
+    }
+    return "error Unknown command";
+}
+
+std::string RecognitionServer::statistics() const {
+    std::ostringstream response;
+    response << std::fixed << std::setprecision(1);
+    for (auto const& name: grammarNames()) {
+        auto latencies = this->latencies(name);
+        if (response.tellp() > 0) {
+            response << ' ';
+        }
+        response << "grammar=" << name << " count=" << latencies.count();
+        std::pair<char const*, double> const percentiles[] = {
+            {"p50", 0.5},
+            {"p90", 0.9},
+            {"p99", 0.99},
+            {"max", 1}
+        };
+        for (auto [key, fraction]: percentiles) {
+            response << ' ' << key << "_us=" << latencies.percentile(fraction) / 1000.0;
+        }
+    }
+    return response.str();
+}
+
+RecognitionClient::RecognitionClient(std::string const& socketPath) {
+    sockaddr_un address;
+    if (!makeAddress(socketPath, address)) {
+        throw ServerSocketException();
+    }
+    _descriptor = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (_descriptor < 0) {
+        throw ServerSocketException();
+    }
+    if (connect(_descriptor, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        close(_descriptor);
+        throw ServerSocketException();
+    }
+}
+
+RecognitionClient::~RecognitionClient() {
+    close(_descriptor);
+}
+
+std::string RecognitionClient::request(std::string const& line) {
+    send(line + '\n');
+    return receiveLine();
+}
+
+std::vector<std::string> RecognitionClient::request(std::vector<std::string> const& lines) {
+    std::vector<std::string> responses;
+    responses.reserve(lines.size());
+    std::string data;
+    for (size_t windowStart = 0; windowStart < lines.size(); windowStart += clientWindowSize) {
+        size_t windowEnd = std::min(windowStart + clientWindowSize, lines.size());
+        data.clear();
+        for (size_t i = windowStart; i < windowEnd; ++i) {
+            data += lines[i];
+            data += '\n';
+        }
+        send(data);
+        for (size_t i = windowStart; i < windowEnd; ++i) {
+            responses.push_back(receiveLine());
+        }
+    }
+    return responses;
+}
+
+bool RecognitionClient::check(std::string const& grammar, std::string_view word) {
+    return check(grammar, std::vector<std::string>{std::string(word)})[0];
+}
+
+std::vector<bool> RecognitionClient::check(
+    std::string const& grammar,
+    std::vector<std::string> const& words
+) {
+    std::vector<std::string> lines;
+    lines.reserve(words.size());
+    for (auto const& word: words) {
+        if (word.find('\n') != std::string::npos) {
+            throw ServerRequestException();
+        }
+        lines.push_back("CHECK " + grammar + ' ' + word);
+    }
+
+    std::vector<bool> results;
+    results.reserve(words.size());
+    for (auto const& response: request(lines)) {
+        if (response != "accept" && response != "reject") {
+            throw ServerRequestException();
+        }
+        results.push_back(response == "accept");
+    }
+    return results;
+}
+
+void RecognitionClient::send(std::string const& data) {
+    if (!sendAll(_descriptor, data)) {
+        throw ServerSocketException();
+    }
+}
+
+std::string RecognitionClient::receiveLine() {
+    char data[4096];
+    for (;;) {
+        size_t lineEnd = _buffer.find('\n');
+        if (lineEnd != std::string::npos) {
+            auto line = _buffer.substr(0, lineEnd);
+            _buffer.erase(0, lineEnd + 1);
+            return line;
+        }
+        auto size = recv(_descriptor, data, sizeof(data), 0);
+        if (size < 0 && errno == EINTR) {
+            continue;
+        }
+        if (size <= 0) {
+            throw ServerSocketException();
+        }
+        _buffer.append(data, size);
+    }
+}
+
+char const* ServerSocketException::what() const throw() {
+    return "Could not communicate over the server socket";
+}
+
+char const* UnknownGrammarException::what() const throw() {
+    return "Server has no grammar with this name";
+}
+
+char const* ServerRequestException::what() const throw() {
+    return "Server rejected the request";
+}
+
+}
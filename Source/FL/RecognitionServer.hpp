@@ -0,0 +1,122 @@
+#pragma once
+
+#include "CYK.hpp"
+#include "LatencyHistogram.hpp"
+#include "ThreadPool.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <exception>
+
+namespace FL {
+
+struct ServerOptions {
+    std::string socketPath;
+    size_t threadCount = 0;
+    size_t maxBatchSize = 64;
+    std::chrono::microseconds batchDelay{200};
+};
+
+class RecognitionServer {
+public:
+    using GrammarSource = std::function<ContextFreeGrammar()>;
+
+    explicit RecognitionServer(ServerOptions const& options);
+    RecognitionServer(RecognitionServer const&) = delete;
+    ~RecognitionServer();
+
+    RecognitionServer& operator=(RecognitionServer const&) = delete;
+
+    ServerOptions const& options() const;
+    void addGrammar(std::string const& name, GrammarSource source);
+    void reloadGrammar(std::string const& name);
+    std::vector<std::string> grammarNames() const;
+    LatencyHistogram latencies(std::string const& name) const;
+    std::future<bool> check(std::string const& name, std::string_view word);
+
+    void run();
+    void stop();
+
+protected:
+    struct Request {
+        std::string word;
+        std::chrono::steady_clock::time_point receiptTime;
+        std::promise<bool> result;
+    };
+
+    struct GrammarEntry {
+        GrammarSource source;
+        std::shared_ptr<CYK const> cyk;
+        std::vector<std::unique_ptr<Request>> queue;
+        LatencyHistogram latencies;
+    };
+
+    void dispatch();
+    void dispatchBatch(std::string const& name, GrammarEntry& grammar);
+    void recognizeBatch(
+        std::string const& name,
+        std::shared_ptr<CYK const> const& cyk,
+        std::vector<std::unique_ptr<Request>>& batch
+    );
+    void serveConnection(int descriptor);
+    std::string respond(std::string_view request, std::future<bool>& result);
+    std::string statistics() const;
+
+    ServerOptions _options;
+    int _listenerDescriptor;
+    std::atomic<bool> _isRunning;
+    mutable std::mutex _mutex;
+    std::condition_variable _condition;
+    std::unordered_map<std::string, GrammarEntry> _grammars;
+    bool _isDispatching;
+    std::unordered_set<int> _connectionDescriptors;
+    size_t _connectionCount;
+    std::condition_variable _connectionsFinished;
+    ThreadPool _pool;
+    std::thread _dispatcher;
+};
+
+class RecognitionClient {
+public:
+    explicit RecognitionClient(std::string const& socketPath);
+    RecognitionClient(RecognitionClient const&) = delete;
+    ~RecognitionClient();
+
+    RecognitionClient& operator=(RecognitionClient const&) = delete;
+
+    std::string request(std::string const& line);
+    std::vector<std::string> request(std::vector<std::string> const& lines);
+    bool check(std::string const& grammar, std::string_view word);
+    std::vector<bool> check(std::string const& grammar, std::vector<std::string> const& words);
+
+protected:
+    void send(std::string const& data);
+    std::string receiveLine();
+
+    int _descriptor;
+    std::string _buffer;
+};
+
+struct ServerSocketException: std::exception {
+    char const* what() const throw();
+};
+
+struct UnknownGrammarException: std::exception {
+    char const* what() const throw();
+};
+
+struct ServerRequestException: std::exception {
+    char const* what() const throw();
+};
+
+}
@@ -0,0 +1,279 @@
+#include "Recognizer.hpp"
+#include "WordGenerator.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace FL {
+
+namespace {
+
+constexpr size_t cacheBytes = 256 * 1024;
+constexpr size_t sampleWordSize = 32;
+constexpr size_t sampleWordCount = 8;
+constexpr size_t minCalibrationSize = 64;
+constexpr size_t calibrationRunCount = 3;
+constexpr std::uint64_t sampleSeed = 0x5eed;
+
+size_t strategyIndex(RecognitionStrategy strategy) {
+    return static_cast<size_t>(strategy);
+}
+
+CYKOptions tiledOptions() {
+    CYKOptions options;
+    options.layout = ChartLayout::TriangularTiled;
+    return options;
+}
+
+template<typename Function>
+double measureSeconds(Function&& function) {
+    auto best = std::numeric_limits<double>::max();
+    for (size_t i = 0; i < calibrationRunCount; ++i) {
+        auto startTime = std::chrono::steady_clock::now();
+        function();
+        best = std::min(best, std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - startTime
+        ).count());
+    }
+    return best;
+}
+
+}
+
+char const* strategyName(RecognitionStrategy strategy) {
+    switch (strategy) {
+    case RecognitionStrategy::Deterministic:
+        return "deterministic";
+    case RecognitionStrategy::DenseChart:
+        return "dense chart";
+    default:
+        return "tiled chart";
+    }
+}
+
+size_t RecognizerStatistics::callCount() const {
+    size_t count = 0;
+    for (auto strategyCount: callCounts) {
+        count += strategyCount;
+    }
+    return count;
+}
+
+Recognizer::Recognizer(ContextFreeGrammar const& grammar, RecognizerOptions const& options):
+    _options(options),
+    _denseCYK(grammar),
+    _tiledCYK(_denseCYK.withOptions(tiledOptions()))
+{
+    describeGrammar();
+    auto words = sampleWords();
+    sampleCellDensity(words);
+    if (_options.calibrates && !words.empty()) {
+        calibrate(words);
+    }
+    if (!_profile.isCalibrated) {
+        auto cellWordCount = (_profile.nonterminalCount + bitsPerCellWord - 1) / bitsPerCellWord;
+        _profile.tiledChartSize = static_cast<size_t>(
+            std::sqrt(cacheBytes / (std::max<size_t>(cellWordCount, 1) * sizeof(std::uint64_t)))
+        );
+    }
+    overrideStrategy(_options.strategy);
+}
+
+GrammarProfile const& Recognizer::profile() const {
+    return _profile;
+}
+
+CYK const& Recognizer::cyk() const {
+    return _denseCYK;
+}
+
+bool Recognizer::isAvailable(RecognitionStrategy strategy) const {
+    return strategy != RecognitionStrategy::Deterministic || _lrTable;
+}
+
+RecognitionStrategy Recognizer::select(size_t wordSize) const {
+    auto strategy = _override.load(std::memory_order_relaxed);
+    if (strategy != noOverride) {
+        return static_cast<RecognitionStrategy>(strategy);
+    }
+    if (_lrTable) {
+        return RecognitionStrategy::Deterministic;
+    }
+    return wordSize >= _profile.tiledChartSize ?
+        RecognitionStrategy::TiledChart :
+        RecognitionStrategy::DenseChart;
+}
+
+void Recognizer::overrideStrategy(std::optional<RecognitionStrategy> strategy) {
+    if (strategy && !isAvailable(*strategy)) {
+        throw UnavailableStrategyException();
+    }
+    _override.store(
+        strategy ? static_cast<int>(*strategy) : noOverride,
+        std::memory_order_relaxed
+    );
+}
+
+bool Recognizer::predict(SymbolSequence const& word) const {
+    return run(word, select(word.size()));
+}
+
+bool Recognizer::predict(SymbolSequence const& word, RecognitionStrategy strategy) const {
+    if (!isAvailable(strategy)) {
+        throw UnavailableStrategyException();
+    }
+    return run(word, strategy);
+}
+
+RecognizerStatistics Recognizer::statistics() const {
+    RecognizerStatistics statistics;
+    for (size_t i = 0; i < recognitionStrategyCount; ++i) {
+        statistics.callCounts[i] = _counters[i].callCount.load(std::memory_order_relaxed);
+        statistics.symbolCounts[i] = _counters[i].symbolCount.load(std::memory_order_relaxed);
+        statistics.acceptedCounts[i] = _counters[i].acceptedCount.load(std::memory_order_relaxed);
+    }
+    return statistics;
+}
+
+void Recognizer::resetStatistics() {
+    for (auto& counters: _counters) {
+        counters.callCount.store(0, std::memory_order_relaxed);
+        counters.symbolCount.store(0, std::memory_order_relaxed);
+        counters.acceptedCount.store(0, std::memory_order_relaxed);
+    }
+}
+
+void Recognizer::describeGrammar() {
+    auto const& grammar = _denseCYK.grammar();
+    _profile.nonterminalCount = grammar.nonterminals().size();
+    _profile.ruleCount = grammar.rules().size();
+    for (auto const& [lhs, rhs]: grammar.rules()) {
+        _profile.binaryRuleCount += rhs.size() == 2;
+    }
+    _profile.rulesPerNonterminal = _profile.nonterminalCount ?
+        static_cast<double>(_profile.ruleCount) / _profile.nonterminalCount :
+        0;
+
+    auto lrTable = std::make_unique<LRTable>(_denseCYK.sourceGrammar());
+    for (auto const& conflict: lrTable->conflicts()) {
+        if (conflict.type == LRConflictType::ShiftReduce) {
+            ++_profile.shiftReduceConflictCount;
+        } else {
+            ++_profile.reduceReduceConflictCount;
+        }
+    }
+    _profile.isDeterministic = lrTable->isDeterministic();
+    if (_profile.isDeterministic) {
+        _lrTable = std::move(lrTable);
+    }
+}
+
+void Recognizer::sampleCellDensity(std::vector<std::string> const& words) {
+    size_t setCount = 0;
+    size_t cellCount = 0;
+    for (auto const& word: words) {
+        auto chart = _denseCYK.chart(word);
+        for (size_t subwordStart = 0; subwordStart < word.size(); ++subwordStart) {
+            for (size_t subwordEnd = subwordStart; subwordEnd < word.size(); ++subwordEnd) {
+                for (auto nonterminal: _denseCYK.grammar().nonterminals()) {
+                    setCount += chart.derives(nonterminal, subwordStart, subwordEnd);
+                }
+                ++cellCount;
+            }
+        }
+    }
+    if (cellCount && _profile.nonterminalCount) {
+        _profile.cellDensity = static_cast<double>(setCount) / cellCount / _profile.nonterminalCount;
+    }
+}
+
+void Recognizer::calibrate(std::vector<std::string> const& words) {
+    WordGenerator::Random random(sampleSeed);
+    double spentSeconds = 0;
+    for (
+        size_t size = minCalibrationSize;
+        size <= _options.maxCalibrationSize;
+        size *= 2
+    ) {
+        std::string word;
+        while (word.size() < size) {
+            word += words[random() % words.size()];
+        }
+        word.resize(size);
+
+        auto denseSeconds = measureSeconds([&] {
+            _denseCYK.predict(word);
+        });
+        auto tiledSeconds = measureSeconds([&] {
+            _tiledCYK.predict(word);
+        });
+        if (tiledSeconds < denseSeconds) {
+            _profile.tiledChartSize = size;
+            _profile.isCalibrated = true;
+            return;
+        }
+
+        spentSeconds += calibrationRunCount * (denseSeconds + tiledSeconds);
+        if (spentSeconds > _options.calibrationBudgetSeconds) {
+            return;
+        }
+    }
+    _profile.isCalibrated = true;
+}
+
+std::vector<std::string> Recognizer::sampleWords() const {
+    std::vector<std::string> words;
+    WordGenerator::Random random(sampleSeed);
+    try {
+        WordGenerator generator(_denseCYK.grammar(), sampleWordSize);
+        std::vector<size_t> sizes;
+        for (size_t size = 1; size <= sampleWordSize; ++size) {
+            if (generator.hasWords(size)) {
+                sizes.push_back(size);
+            }
+        }
+        for (size_t i = 0; i < sampleWordCount && !sizes.empty(); ++i) {
+            words.push_back(generator.generate(sizes[random() % sizes.size()], random));
+        }
+        if (words.empty() && !generator.alphabet().empty()) {
+            for (size_t i = 0; i < sampleWordCount; ++i) {
+                std::string word;
+                for (size_t j = 0; j < sampleWordSize; ++j) {
+                    word += generator.alphabet()[random() % generator.alphabet().size()];
+                }
+                words.push_back(word);
+            }
+        }
+    } catch (NonByteAlphabetException const&) {}
+    return words;
+}
+
+bool Recognizer::run(SymbolSequence const& word, RecognitionStrategy strategy) const {
+    bool isAccepted;
+    switch (strategy) {
+    case RecognitionStrategy::Deterministic: {
+        thread_local std::vector<std::uint32_t> stack;
+        isAccepted = _lrTable->predict(word, stack);
+        break;
+    }
+    case RecognitionStrategy::DenseChart:
+        isAccepted = _denseCYK.predict(word);
+        break;
+    default:
+        isAccepted = _tiledCYK.predict(word);
+        break;
+    }
+
+    auto& counters = _counters[strategyIndex(strategy)];
+    counters.callCount.fetch_add(1, std::memory_order_relaxed);
+    counters.symbolCount.fetch_add(word.size(), std::memory_order_relaxed);
+    counters.acceptedCount.fetch_add(isAccepted, std::memory_order_relaxed);
+    return isAccepted;
+}
+
+char const* UnavailableStrategyException::what() const throw() {
+    return "Recognition strategy is not available for this grammar";
+}
+
+}
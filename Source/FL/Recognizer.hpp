@@ -0,0 +1,103 @@
+#pragma once
+
+#include "ContextFreeGrammar.hpp"
+#include "CYK.hpp"
+#include "LRTable.hpp"
+#include "SymbolSequence.hpp"
+#include <array>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+#include <exception>
+
+namespace FL {
+
+enum class RecognitionStrategy {
+    Deterministic,
+    DenseChart,
+    TiledChart
+};
+
+constexpr size_t recognitionStrategyCount = 3;
+
+char const* strategyName(RecognitionStrategy strategy);
+
+struct RecognizerOptions {
+    std::optional<RecognitionStrategy> strategy;
+    bool calibrates = false;
+    size_t maxCalibrationSize = 512;
+    double calibrationBudgetSeconds = 0.05;
+};
+
+struct GrammarProfile {
+    size_t nonterminalCount = 0;
+    size_t ruleCount = 0;
+    size_t binaryRuleCount = 0;
+    size_t shiftReduceConflictCount = 0;
+    size_t reduceReduceConflictCount = 0;
+    bool isDeterministic = false;
+    double rulesPerNonterminal = 0;
+    double cellDensity = 0;
+    size_t tiledChartSize = std::numeric_limits<size_t>::max();
+    bool isCalibrated = false;
+};
+
+struct RecognizerStatistics {
+    std::array<size_t, recognitionStrategyCount> callCounts{};
+    std::array<size_t, recognitionStrategyCount> symbolCounts{};
+    std::array<size_t, recognitionStrategyCount> acceptedCounts{};
+
+    size_t callCount() const;
+};
+
+class Recognizer {
+public:
+    explicit Recognizer(ContextFreeGrammar const& grammar, RecognizerOptions const& options = {});
+
+    Recognizer(Recognizer const&) = delete;
+    Recognizer& operator=(Recognizer const&) = delete;
+
+    GrammarProfile const& profile() const;
+    CYK const& cyk() const;
+    bool isAvailable(RecognitionStrategy strategy) const;
+    RecognitionStrategy select(size_t wordSize) const;
+    void overrideStrategy(std::optional<RecognitionStrategy> strategy);
+
+    bool predict(SymbolSequence const& word) const;
+    bool predict(SymbolSequence const& word, RecognitionStrategy strategy) const;
+
+    RecognizerStatistics statistics() const;
+    void resetStatistics();
+
+protected:
+    struct Counters {
+        std::atomic<size_t> callCount{0};
+        std::atomic<size_t> symbolCount{0};
+        std::atomic<size_t> acceptedCount{0};
+    };
+
+    static constexpr int noOverride = -1;
+
+    void describeGrammar();
+    void sampleCellDensity(std::vector<std::string> const& words);
+    void calibrate(std::vector<std::string> const& words);
+    std::vector<std::string> sampleWords() const;
+    bool run(SymbolSequence const& word, RecognitionStrategy strategy) const;
+
+    RecognizerOptions _options;
+    CYK _denseCYK;
+    CYK _tiledCYK;
+    std::unique_ptr<LRTable> _lrTable;
+    GrammarProfile _profile;
+    std::atomic<int> _override{noOverride};
+    mutable std::array<Counters, recognitionStrategyCount> _counters;
+};
+
+struct UnavailableStrategyException: std::exception {
+    char const* what() const throw();
+};
+
+}
@@ -0,0 +1,91 @@
+#include "ScratchFile.hpp"
+
+#include <utility>
+#include <cstdint>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <stdlib.h>
+
+namespace FL {
+
+ScratchFile::ScratchFile(ScratchFile&& scratchFile):
+    _descriptor(std::exchange(scratchFile._descriptor, -1)),
+    _data(std::exchange(scratchFile._data, nullptr)),
+    _size(std::exchange(scratchFile._size, 0))
+{}
+
+ScratchFile::~ScratchFile() {
+    unmap();
+}
+
+ScratchFile& ScratchFile::operator=(ScratchFile&& scratchFile) {
+    if (this != &scratchFile) {
+        unmap();
+        _descriptor = std::exchange(scratchFile._descriptor, -1);
+        _data = std::exchange(scratchFile._data, nullptr);
+        _size = std::exchange(scratchFile._size, 0);
+    }
+    return *this;
+}
+
+void* ScratchFile::data() const {
+    return _data;
+}
+
+size_t ScratchFile::size() const {
+    return _size;
+}
+
+void ScratchFile::map(std::string const& directory, size_t size) {
+    unmap();
+
+    std::string path = (directory.empty() ? "." : directory) + "/flp-chart-XXXXXX";
+    _descriptor = mkstemp(path.data());
+    if (_descriptor < 0) {
+        throw ScratchFileException();
+    }
+    unlink(path.c_str());
+
+    if (ftruncate(_descriptor, size) != 0) {
+        unmap();
+        throw ScratchFileException();
+    }
+    _data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, _descriptor, 0);
+    if (_data == MAP_FAILED) {
+        _data = nullptr;
+        unmap();
+        throw ScratchFileException();
+    }
+    _size = size;
+}
+
+void ScratchFile::clear() {
+    if (ftruncate(_descriptor, 0) != 0 || ftruncate(_descriptor, _size) != 0) {
+        throw ScratchFileException();
+    }
+}
+
+void ScratchFile::prefetch(void const* begin, size_t size) const {
+    auto pageSize = static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE));
+    auto address = reinterpret_cast<std::uintptr_t>(begin);
+    auto pageStart = address & ~(pageSize - 1);
+    madvise(reinterpret_cast<void*>(pageStart), address + size - pageStart, MADV_WILLNEED);
+}
+
+void ScratchFile::unmap() {
+    if (_data) {
+        munmap(_data, _size);
+    }
+    if (_descriptor >= 0) {
+        close(_descriptor);
+    }
+    _descriptor = -1;
+    _data = nullptr;
+    _size = 0;
+}
+
+char const* ScratchFileException::what() const throw() {
+    return "Could not create chart scratch file";
+}
+
+}
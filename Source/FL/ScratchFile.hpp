@@ -0,0 +1,37 @@
+#pragma once
+
+#include <string>
+#include <exception>
+
+namespace FL {
+
+class ScratchFile {
+public:
+    ScratchFile() = default;
+    ScratchFile(ScratchFile const&) = delete;
+    ScratchFile(ScratchFile&& scratchFile);
+    ~ScratchFile();
+
+    ScratchFile& operator=(ScratchFile const&) = delete;
+    ScratchFile& operator=(ScratchFile&& scratchFile);
+
+    void* data() const;
+    size_t size() const;
+
+    void map(std::string const& directory, size_t size);
+    void clear();
+    void prefetch(void const* begin, size_t size) const;
+
+protected:
+    void unmap();
+
+    int _descriptor = -1;
+    void* _data = nullptr;
+    size_t _size = 0;
+};
+
+struct ScratchFileException: std::exception {
+    char const* what() const throw();
+};
+
+}
@@ -0,0 +1,162 @@
+#include "SearchCYK.hpp"
+
+#include <algorithm>
+
+namespace FL {
+
+namespace {
+
+constexpr size_t inputBufferSize = 64 * 1024;
+
+}
+
+bool Match::operator==(Match const& match) const {
+    return offset == match.offset && size == match.size;
+}
+
+bool Match::operator!=(Match const& match) const {
+    return !(*this == match);
+}
+
+SearchCYK::Scanner::Scanner(SearchCYK const& searcher, MatchHandler handler):
+    _searcher(searcher),
+    _handler(std::move(handler)),
+    _windowSize(searcher._searchOptions.maxMatchSize),
+    _columns(_windowSize * _windowSize * searcher._cellSize),
+    _longestMatchSizes(_windowSize),
+    _position(0),
+    _nextMatchStart(0)
+{}
+
+size_t SearchCYK::Scanner::position() const {
+    return _position;
+}
+
+void SearchCYK::Scanner::feed(char const* data, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+        calculateColumn(data[i]);
+        if (
+            _searcher._searchOptions.semantics == MatchSemantics::LeftmostLongest &&
+            _position >= _windowSize
+        ) {
+            reportMatches(_position - _windowSize + 1);
+        }
+    }
+}
+
+void SearchCYK::Scanner::finish() {
+    if (_searcher._searchOptions.semantics == MatchSemantics::LeftmostLongest) {
+        reportMatches(_position);
+    }
+}
+
+std::uint64_t* SearchCYK::Scanner::cell(size_t subwordEnd, size_t subwordSize) {
+    size_t column = subwordEnd % _windowSize;
+    return _columns.data() + (column * _windowSize + subwordSize - 1) * _searcher._cellSize;
+}
+
+void SearchCYK::Scanner::calculateColumn(char character) {
+    size_t subwordEnd = _position++;
+    auto column = cell(subwordEnd, 1);
+    std::fill(column, column + _windowSize * _searcher._cellSize, 0);
+    _longestMatchSizes[subwordEnd % _windowSize] = 0;
+
+    auto terminalValues = _searcher._terminalCells.find(character);
+    if (terminalValues != _searcher._terminalCells.end()) {
+        std::copy(terminalValues->second.begin(), terminalValues->second.end(), column);
+    }
+
+    size_t maxSubwordSize = std::min(_windowSize, subwordEnd + 1);
+    for (size_t subwordSize = 2; subwordSize <= maxSubwordSize; ++subwordSize) {
+        size_t subwordStart = subwordEnd - subwordSize + 1;
+        auto values = cell(subwordEnd, subwordSize);
+        for (size_t i = subwordStart; i < subwordEnd; ++i) {
+            _searcher.combineCells(
+                cell(i, i - subwordStart + 1),
+                cell(subwordEnd, subwordEnd - i),
+                values
+            );
+        }
+    }
+
+    size_t startIndex = _searcher._startIndex;
+    for (size_t subwordSize = 1; subwordSize <= maxSubwordSize; ++subwordSize) {
+        auto values = cell(subwordEnd, subwordSize);
+        if (!((values[startIndex / bitsPerCellWord] >> (startIndex % bitsPerCellWord)) & 1)) {
+            continue;
+        }
+        size_t subwordStart = subwordEnd - subwordSize + 1;
+        if (_searcher._searchOptions.semantics == MatchSemantics::All) {
+            _handler({subwordStart, subwordSize});
+        } else {
+            _longestMatchSizes[subwordStart % _windowSize] = subwordSize;
+        }
+    }
+}
+
+void SearchCYK::Scanner::reportMatches(size_t matchStartsEnd) {
+    while (_nextMatchStart < matchStartsEnd) {
+        size_t matchSize = _longestMatchSizes[_nextMatchStart % _windowSize];
+        if (matchSize) {
+            _handler({_nextMatchStart, matchSize});
+            _nextMatchStart += matchSize;
+        } else {
+            ++_nextMatchStart;
+        }
+    }
+}
+
+SearchCYK::SearchCYK(
+    ContextFreeGrammar const& grammar,
+    SearchOptions const& searchOptions,
+    CYKOptions const& options
+):
+    CYK(grammar, options),
+    _searchOptions(searchOptions)
+{
+    if (!_searchOptions.maxMatchSize) {
+        throw InvalidSearchWindowException();
+    }
+}
+
+SearchCYK::SearchCYK(CYK const& cyk, SearchOptions const& searchOptions):
+    CYK(cyk),
+    _searchOptions(searchOptions)
+{
+    if (!_searchOptions.maxMatchSize) {
+        throw InvalidSearchWindowException();
+    }
+}
+
+SearchOptions const& SearchCYK::searchOptions() const {
+    return _searchOptions;
+}
+
+SearchCYK::Scanner SearchCYK::scanner(MatchHandler handler) const {
+    return Scanner(*this, std::move(handler));
+}
+
+std::vector<Match> SearchCYK::search(std::string const& text) const {
+    std::vector<Match> matches;
+    auto scanner = this->scanner([&matches](Match const& match) {
+        matches.push_back(match);
+    });
+    scanner.feed(text.data(), text.size());
+    scanner.finish();
+    return matches;
+}
+
+void SearchCYK::search(std::istream& input, MatchHandler handler) const {
+    auto scanner = this->scanner(std::move(handler));
+    std::vector<char> buffer(inputBufferSize);
+    while (input.read(buffer.data(), buffer.size()) || input.gcount()) {
+        scanner.feed(buffer.data(), input.gcount());
+    }
+    scanner.finish();
+}
+
+char const* InvalidSearchWindowException::what() const throw() {
+    return "Maximum match size must be positive";
+}
+
+}
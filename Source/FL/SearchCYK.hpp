@@ -0,0 +1,73 @@
+#pragma once
+
+#include "CYK.hpp"
+#include <istream>
+#include <functional>
+
+namespace FL {
+
+enum class MatchSemantics {
+    LeftmostLongest,
+    All
+};
+
+struct SearchOptions {
+    size_t maxMatchSize = 256;
+    MatchSemantics semantics = MatchSemantics::LeftmostLongest;
+};
+
+struct Match {
+    size_t offset;
+    size_t size;
+
+    bool operator==(Match const& match) const;
+    bool operator!=(Match const& match) const;
+};
+
+class SearchCYK: public CYK {
+public:
+    using MatchHandler = std::function<void(Match const&)>;
+
+    class Scanner {
+    public:
+        Scanner(SearchCYK const& searcher, MatchHandler handler);
+
+        size_t position() const;
+        void feed(char const* data, size_t size);
+        void finish();
+
+    protected:
+        std::uint64_t* cell(size_t subwordEnd, size_t subwordSize);
+        void calculateColumn(char character);
+        void reportMatches(size_t matchStartsEnd);
+
+        SearchCYK const& _searcher;
+        MatchHandler _handler;
+        size_t _windowSize;
+        std::vector<std::uint64_t> _columns;
+        std::vector<size_t> _longestMatchSizes;
+        size_t _position;
+        size_t _nextMatchStart;
+    };
+
+    explicit SearchCYK(
+        ContextFreeGrammar const& grammar,
+        SearchOptions const& searchOptions = {},
+        CYKOptions const& options = {}
+    );
+    explicit SearchCYK(CYK const& cyk, SearchOptions const& searchOptions = {});
+
+    SearchOptions const& searchOptions() const;
+    Scanner scanner(MatchHandler handler) const;
+    std::vector<Match> search(std::string const& text) const;
+    void search(std::istream& input, MatchHandler handler) const;
+
+protected:
+    SearchOptions _searchOptions;
+};
+
+struct InvalidSearchWindowException: std::exception {
+    char const* what() const throw();
+};
+
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include "Grammar.hpp"
+#include <array>
+#include <limits>
+#include <cmath>
+#include <cstdint>
+
+namespace FL {
+
+struct BooleanSemiring {
+    using Value = bool;
+
+    static Value zero() {
+        return false;
+    }
+
+    static Value one() {
+        return true;
+    }
+
+    static Value plus(Value lhs, Value rhs) {
+        return lhs || rhs;
+    }
+
+    static Value times(Value lhs, Value rhs) {
+        return lhs && rhs;
+    }
+
+    static Value ruleWeight(Grammar::Rule const&) {
+        return one();
+    }
+};
+
+struct CountingSemiring {
+    using Value = std::uint64_t;
+
+    static Value zero() {
+        return 0;
+    }
+
+    static Value one() {
+        return 1;
+    }
+
+    static Value plus(Value lhs, Value rhs) {
+        return lhs + rhs;
+    }
+
+    static Value times(Value lhs, Value rhs) {
+        return lhs * rhs;
+    }
+
+    static Value ruleWeight(Grammar::Rule const&) {
+        return one();
+    }
+};
+
+struct ViterbiSemiring {
+    using Value = float;
+
+    static Value zero() {
+        return -std::numeric_limits<Value>::infinity();
+    }
+
+    static Value one() {
+        return 0;
+    }
+
+    static Value plus(Value lhs, Value rhs) {
+        return lhs < rhs ? rhs : lhs;
+    }
+
+    static Value times(Value lhs, Value rhs) {
+        return lhs + rhs;
+    }
+
+    static Value ruleWeight(Grammar::Rule const& rule) {
+        return std::log(rule.probability);
+    }
+};
+
+template<size_t K>
+struct KBestSemiring {
+    using Value = std::array<ViterbiSemiring::Value, K>;
+
+    static Value zero() {
+        Value value;
+        value.fill(ViterbiSemiring::zero());
+        return value;
+    }
+
+    static Value one() {
+        auto value = zero();
+        value[0] = ViterbiSemiring::one();
+        return value;
+    }
+
+    static Value plus(Value const& lhs, Value const& rhs) {
+        Value value;
+        for (size_t i = 0, j = 0, k = 0; k < K; ++k) {
+            value[k] = lhs[i] < rhs[j] ? rhs[j++] : lhs[i++];
+        }
+        return value;
+    }
+
+    static Value times(Value const& lhs, Value const& rhs) {
+        auto value = zero();
+        for (size_t i = 0; i < K && lhs[i] != ViterbiSemiring::zero(); ++i) {
+            for (size_t j = 0; j < K && rhs[j] != ViterbiSemiring::zero(); ++j) {
+                auto product = ViterbiSemiring::times(lhs[i], rhs[j]);
+                if (product <= value[K - 1]) {
+                    break;
+                }
+                size_t k = K - 1;
+                for (; k > 0 && value[k - 1] < product; --k) {
+                    value[k] = value[k - 1];
+                }
+                value[k] = product;
+            }
+        }
+        return value;
+    }
+
+    static Value ruleWeight(Grammar::Rule const& rule) {
+        auto value = zero();
+        value[0] = ViterbiSemiring::ruleWeight(rule);
+        return value;
+    }
+};
+
+}
@@ -0,0 +1,9 @@
+#include "SemiringCYK.hpp"
+
+namespace FL {
+
+char const* UnsupportedSemiringOptionsException::what() const throw() {
+    return "Semiring charts do not support memoization or out-of-core storage";
+}
+
+}
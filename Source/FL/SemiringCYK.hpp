@@ -0,0 +1,217 @@
+#pragma once
+
+#include "CYK.hpp"
+#include "Semiring.hpp"
+#include <type_traits>
+#include <memory>
+#include <exception>
+
+namespace FL {
+
+struct UnsupportedSemiringOptionsException: std::exception {
+    char const* what() const throw();
+};
+
+template<typename Semiring>
+class SemiringCYK: public CYK {
+public:
+    using Value = typename Semiring::Value;
+
+    // Typed charts honour layout and tileSize. Except for BooleanSemiring, which runs
+    // CYK::predict, memoizeRepeatedSubwords and maxInMemoryChartSize are rejected.
+    explicit SemiringCYK(ContextFreeGrammar const& grammar, CYKOptions const& options = {});
+
+    Value evaluate(SymbolSequence const& word) const;
+    Value evaluate(SymbolSequence const& word, Workspace& workspace) const;
+
+protected:
+    struct WeightedRule {
+        size_t rightChild;
+        size_t parent;
+        Value weight;
+    };
+
+    struct ValueTable {
+        Value* values;
+        std::ptrdiff_t const* rowOffsets;
+        std::ptrdiff_t const* columnOffsets;
+        size_t cellSize;
+
+        Value* cell(size_t subwordStart, size_t subwordEnd) const;
+    };
+
+    void compileWeights();
+    ValueTable initTable(SymbolSequence const& word, Workspace& workspace) const;
+    void calculateSubwordValues(
+        ValueTable const& table,
+        size_t subwordStart,
+        size_t subwordSize
+    ) const;
+    ValueTable calculateTableValues(SymbolSequence const& word, Workspace& workspace) const;
+
+    Value _emptyWordValue;
+    std::unordered_map<Symbol, std::vector<std::pair<size_t, Value>>> _terminalRules;
+    std::vector<size_t> _weightedRulesByLeftChild;
+    std::vector<WeightedRule> _weightedRules;
+};
+
+template<typename Semiring>
+SemiringCYK<Semiring>::SemiringCYK(ContextFreeGrammar const& grammar, CYKOptions const& options):
+    CYK(grammar, options)
+{
+    if constexpr (!std::is_same_v<Semiring, BooleanSemiring>) {
+        if (options.memoizeRepeatedSubwords || options.maxInMemoryChartSize) {
+            throw UnsupportedSemiringOptionsException();
+        }
+    }
+    compileWeights();
+}
+
+template<typename Semiring>
+typename SemiringCYK<Semiring>::Value SemiringCYK<Semiring>::evaluate(
+    SymbolSequence const& word
+) const {
+    thread_local Workspace workspace;
+    return evaluate(word, workspace);
+}
+
+template<typename Semiring>
+typename SemiringCYK<Semiring>::Value SemiringCYK<Semiring>::evaluate(
+    SymbolSequence const& word,
+    Workspace& workspace
+) const {
+    if constexpr (std::is_same_v<Semiring, BooleanSemiring>) {
+        return predict(word, workspace);
+    } else {
+        if (word.empty()) {
+            return _emptyWordValue;
+        }
+
+        auto table = calculateTableValues(word, workspace);
+        return table.cell(0, word.size() - 1)[_startIndex];
+    }
+}
+
+template<typename Semiring>
+void SemiringCYK<Semiring>::compileWeights() {
+    _emptyWordValue = Semiring::zero();
+    std::vector<std::vector<WeightedRule>> rulesByLeftChild(_nonterminals.size());
+    for (auto const& rule: _grammar->rules()) {
+        auto const& [lhs, rhs] = rule;
+        auto parent = _nonterminalIndices.at(lhs[0]);
+        auto weight = Semiring::ruleWeight(rule);
+        if (rhs.empty() && parent == _startIndex) {
+            _emptyWordValue = Semiring::plus(_emptyWordValue, weight);
+        } else if (rhs.size() == 1 && _grammar->symbolIsTerminal(rhs[0])) {
+            _terminalRules[rhs[0]].emplace_back(parent, weight);
+        } else if (rhs.size() == 2) {
+            rulesByLeftChild[_nonterminalIndices.at(rhs[0])].push_back({
+                _nonterminalIndices.at(rhs[1]),
+                parent,
+                weight
+            });
+        }
+    }
+
+    _weightedRulesByLeftChild.assign(1, 0);
+    for (auto const& rules: rulesByLeftChild) {
+        _weightedRules.insert(_weightedRules.end(), rules.begin(), rules.end());
+        _weightedRulesByLeftChild.push_back(_weightedRules.size());
+    }
+}
+
+template<typename Semiring>
+typename SemiringCYK<Semiring>::Value* SemiringCYK<Semiring>::ValueTable::cell(
+    size_t subwordStart,
+    size_t subwordEnd
+) const {
+    return values + (rowOffsets[subwordStart] + columnOffsets[subwordEnd]) * cellSize;
+}
+
+template<typename Semiring>
+typename SemiringCYK<Semiring>::ValueTable SemiringCYK<Semiring>::initTable(
+    SymbolSequence const& word,
+    Workspace& workspace
+) const {
+    static_assert(std::is_trivially_copyable_v<Value>);
+    static_assert(alignof(Value) <= alignof(std::uint64_t));
+
+    size_t valueCount = layoutTable(word.size(), _options.layout, workspace) * _nonterminals.size();
+    size_t cellWordCount = (
+        (valueCount * sizeof(Value) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t)
+    );
+    auto values = reinterpret_cast<Value*>(workspace.reserve(workspace._cells, cellWordCount));
+    std::uninitialized_fill_n(values, valueCount, Semiring::zero());
+
+    ValueTable table{
+        values,
+        workspace._rowOffsets.data(),
+        workspace._columnOffsets.data(),
+        _nonterminals.size()
+    };
+    for (size_t i = 0; i < word.size(); ++i) {
+        auto terminalRules = _terminalRules.find(word[i]);
+        if (terminalRules == _terminalRules.end()) {
+            continue;
+        }
+        auto values = table.cell(i, i);
+        for (auto const& [parent, weight]: terminalRules->second) {
+            values[parent] = Semiring::plus(values[parent], weight);
+        }
+    }
+
+    return table;
+}
+
+template<typename Semiring>
+void SemiringCYK<Semiring>::calculateSubwordValues(
+    ValueTable const& table,
+    size_t subwordStart,
+    size_t subwordSize
+) const {
+    size_t subwordEnd = subwordStart + subwordSize - 1;
+    auto values = table.cell(subwordStart, subwordEnd);
+    for (size_t i = subwordStart; i < subwordEnd; ++i) {
+        auto leftValues = table.cell(subwordStart, i);
+        auto rightValues = table.cell(i + 1, subwordEnd);
+        for (size_t leftChild = 0; leftChild < _nonterminals.size(); ++leftChild) {
+            if (leftValues[leftChild] == Semiring::zero()) {
+                continue;
+            }
+            for (
+                size_t j = _weightedRulesByLeftChild[leftChild];
+                j < _weightedRulesByLeftChild[leftChild + 1];
+                ++j
+            ) {
+                auto const& [rightChild, parent, weight] = _weightedRules[j];
+                if (rightValues[rightChild] == Semiring::zero()) {
+                    continue;
+                }
+                values[parent] = Semiring::plus(
+                    values[parent],
+                    Semiring::times(
+                        weight,
+                        Semiring::times(leftValues[leftChild], rightValues[rightChild])
+                    )
+                );
+            }
+        }
+    }
+}
+
+template<typename Semiring>
+typename SemiringCYK<Semiring>::ValueTable SemiringCYK<Semiring>::calculateTableValues(
+    SymbolSequence const& word,
+    Workspace& workspace
+) const {
+    auto table = initTable(word, workspace);
+    for (size_t subwordSize = 2; subwordSize <= word.size(); ++subwordSize) {
+        for (size_t subwordStart = 0; subwordStart + subwordSize <= word.size(); ++subwordStart) {
+            calculateSubwordValues(table, subwordStart, subwordSize);
+        }
+    }
+
+    return table;
+}
+
+}
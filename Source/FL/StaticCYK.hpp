@@ -0,0 +1,502 @@
+#pragma once
+
+#include "ContextFreeGrammar.hpp"
+#include "SymbolSequence.hpp"
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
+#include <cstdint>
+
+namespace FL {
+
+struct StaticRule {
+    char lhs;
+    char const* rhs;
+};
+
+template<size_t size>
+class StaticBitset {
+public:
+    constexpr bool test(size_t index) const;
+    constexpr void set(size_t index);
+    constexpr bool any() const;
+    constexpr StaticBitset& operator|=(StaticBitset const& bitset);
+    constexpr bool operator==(StaticBitset const& bitset) const;
+
+protected:
+    std::array<std::uint64_t, size / 64 + 1> _words{};
+};
+
+// Definition provides `terminals`, `nonterminals` (character strings), `startSymbol` and
+// `rules` (an array of StaticRule); the grammar is normalized when the template is instantiated.
+template<typename Definition>
+class StaticGrammar {
+public:
+    struct BinaryRule {
+        size_t lhs;
+        size_t left;
+        size_t right;
+    };
+
+    struct TerminalRule {
+        size_t lhs;
+        char terminal;
+    };
+
+protected:
+    struct UnitRule {
+        size_t lhs;
+        size_t rhs;
+    };
+
+    static constexpr size_t noSymbol = std::numeric_limits<size_t>::max();
+
+    static constexpr size_t length(char const* string);
+    static constexpr size_t find(char const* symbols, char symbol);
+    static constexpr size_t countRuleSymbols();
+    static constexpr size_t findMaxRuleSize();
+
+    static constexpr size_t _terminalCount = length(Definition::terminals);
+    static constexpr size_t _sourceNonterminalCount = length(Definition::nonterminals);
+    static constexpr size_t _ruleCount = std::size(Definition::rules);
+    static constexpr size_t _ruleSymbolCount = countRuleSymbols();
+    static constexpr size_t _maxRuleSize = findMaxRuleSize();
+    static constexpr size_t _nonterminalCapacity =
+        _sourceNonterminalCount + _terminalCount + _ruleSymbolCount;
+    static constexpr size_t _binaryRuleCapacity = _ruleSymbolCount + 1;
+    static constexpr size_t _unitRuleCapacity = _ruleCount + 2 * _ruleSymbolCount + 1;
+    static constexpr size_t _terminalRuleCapacity = _ruleCount + _terminalCount + 1;
+
+    struct Normalization {
+        size_t nonterminalCount;
+        size_t startSymbol;
+        bool acceptsEmptyWord;
+        std::array<BinaryRule, _nonterminalCapacity * _binaryRuleCapacity> binaryRules;
+        size_t binaryRuleCount;
+        std::array<TerminalRule, _nonterminalCapacity * _terminalRuleCapacity> terminalRules;
+        size_t terminalRuleCount;
+    };
+
+    static constexpr Normalization normalize();
+    template<typename Rule, size_t count, size_t capacity>
+    static constexpr std::array<Rule, count> takeRules(std::array<Rule, capacity> const& rules);
+
+    static constexpr Normalization _normalization = normalize();
+
+public:
+    static constexpr size_t nonterminalCount = _normalization.nonterminalCount;
+    static constexpr size_t startSymbol = _normalization.startSymbol;
+    static constexpr bool acceptsEmptyWord = _normalization.acceptsEmptyWord;
+    static constexpr auto binaryRules =
+        takeRules<BinaryRule, _normalization.binaryRuleCount>(_normalization.binaryRules);
+    static constexpr auto terminalRules =
+        takeRules<TerminalRule, _normalization.terminalRuleCount>(_normalization.terminalRules);
+
+    static ContextFreeGrammar contextFreeGrammar();
+};
+
+template<typename Definition>
+class StaticCYK {
+public:
+    using Grammar = StaticGrammar<Definition>;
+    using Bitset = StaticBitset<Grammar::nonterminalCount>;
+    using Workspace = std::vector<Bitset>;
+
+    static bool predict(SymbolSequence const& word);
+    static bool predict(SymbolSequence const& word, Workspace& workspace);
+
+protected:
+    using TerminalMasks = std::array<Bitset, std::numeric_limits<unsigned char>::max() + 1>;
+
+    static constexpr TerminalMasks makeTerminalMasks();
+    template<size_t... indices>
+    static void applyRules(
+        Bitset& cell,
+        Bitset const& left,
+        Bitset const& right,
+        std::index_sequence<indices...>
+    );
+    template<size_t index>
+    static void applyRule(Bitset& cell, Bitset const& left, Bitset const& right);
+
+    static constexpr TerminalMasks _terminalMasks = makeTerminalMasks();
+};
+
+template<size_t size>
+constexpr bool StaticBitset<size>::test(size_t index) const {
+    return (_words[index / 64] >> (index % 64)) & 1;
+}
+
+template<size_t size>
+constexpr void StaticBitset<size>::set(size_t index) {
+    _words[index / 64] |= std::uint64_t(1) << (index % 64);
+}
+
+template<size_t size>
+constexpr bool StaticBitset<size>::any() const {
+    for (auto word: _words) {
+        if (word != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template<size_t size>
+constexpr StaticBitset<size>& StaticBitset<size>::operator|=(StaticBitset const& bitset) {
+    for (size_t i = 0; i < _words.size(); ++i) {
+        _words[i] |= bitset._words[i];
+    }
+    return *this;
+}
+
+template<size_t size>
+constexpr bool StaticBitset<size>::operator==(StaticBitset const& bitset) const {
+    for (size_t i = 0; i < _words.size(); ++i) {
+        if (_words[i] != bitset._words[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<typename Definition>
+constexpr size_t StaticGrammar<Definition>::length(char const* string) {
+    size_t size = 0;
+    while (string[size] != '\0') {
+        ++size;
+    }
+    return size;
+}
+
+template<typename Definition>
+constexpr size_t StaticGrammar<Definition>::find(char const* symbols, char symbol) {
+    for (size_t i = 0; symbols[i] != '\0'; ++i) {
+        if (symbols[i] == symbol) {
+            return i;
+        }
+    }
+    return noSymbol;
+}
+
+template<typename Definition>
+constexpr size_t StaticGrammar<Definition>::countRuleSymbols() {
+    size_t count = 0;
+    for (auto const& rule: Definition::rules) {
+        count += length(rule.rhs);
+    }
+    return count;
+}
+
+template<typename Definition>
+constexpr size_t StaticGrammar<Definition>::findMaxRuleSize() {
+    size_t maxSize = 1;
+    for (auto const& rule: Definition::rules) {
+        maxSize = std::max(maxSize, length(rule.rhs));
+    }
+    return maxSize;
+}
+
+template<typename Definition>
+constexpr typename StaticGrammar<Definition>::Normalization StaticGrammar<Definition>::normalize() {
+    using Nonterminals = StaticBitset<_nonterminalCapacity>;
+
+    std::array<BinaryRule, _binaryRuleCapacity> binaryRules{};
+    size_t binaryRuleCount = 0;
+    std::array<UnitRule, _unitRuleCapacity> unitRules{};
+    size_t unitRuleCount = 0;
+    std::array<TerminalRule, _terminalRuleCapacity> terminalRules{};
+    size_t terminalRuleCount = 0;
+    std::array<bool, _nonterminalCapacity> isNullable{};
+    std::array<size_t, _terminalCount + 1> terminalNonterminals{};
+    for (auto& nonterminal: terminalNonterminals) {
+        nonterminal = noSymbol;
+    }
+    auto nonterminalCount = _sourceNonterminalCount;
+
+    auto startSymbol = find(Definition::nonterminals, Definition::startSymbol);
+    if (startSymbol == noSymbol) {
+        throw IncorrectGrammarException();
+    }
+    for (auto const& rule: Definition::rules) {
+        auto lhs = find(Definition::nonterminals, rule.lhs);
+        if (lhs == noSymbol) {
+            throw IncorrectGrammarException();
+        }
+        auto size = length(rule.rhs);
+        if (size == 0) {
+            isNullable[lhs] = true;
+            continue;
+        }
+
+        std::array<size_t, _maxRuleSize> symbols{};
+        for (size_t i = 0; i < size; ++i) {
+            symbols[i] = find(Definition::nonterminals, rule.rhs[i]);
+            if (symbols[i] != noSymbol) {
+                continue;
+            }
+            auto terminal = find(Definition::terminals, rule.rhs[i]);
+            if (terminal == noSymbol) {
+                throw IncorrectGrammarException();
+            }
+            if (size == 1) {
+                terminalRules[terminalRuleCount++] = {lhs, rule.rhs[i]};
+            } else {
+                if (terminalNonterminals[terminal] == noSymbol) {
+                    terminalNonterminals[terminal] = nonterminalCount++;
+                    terminalRules[terminalRuleCount++] = {nonterminalCount - 1, rule.rhs[i]};
+                }
+                symbols[i] = terminalNonterminals[terminal];
+            }
+        }
+
+        if (size == 1) {
+            if (symbols[0] != noSymbol) {
+                unitRules[unitRuleCount++] = {lhs, symbols[0]};
+            }
+            continue;
+        }
+        for (size_t i = 0; i + 2 < size; ++i) {
+            binaryRules[binaryRuleCount++] = {lhs, symbols[i], nonterminalCount};
+            lhs = nonterminalCount++;
+        }
+        binaryRules[binaryRuleCount++] = {lhs, symbols[size - 2], symbols[size - 1]};
+    }
+
+    for (bool isChanged = true; isChanged;) {
+        isChanged = false;
+        for (size_t i = 0; i < binaryRuleCount; ++i) {
+            auto const& rule = binaryRules[i];
+            if (!isNullable[rule.lhs] && isNullable[rule.left] && isNullable[rule.right]) {
+                isNullable[rule.lhs] = isChanged = true;
+            }
+        }
+        for (size_t i = 0; i < unitRuleCount; ++i) {
+            if (!isNullable[unitRules[i].lhs] && isNullable[unitRules[i].rhs]) {
+                isNullable[unitRules[i].lhs] = isChanged = true;
+            }
+        }
+    }
+    for (size_t i = 0; i < binaryRuleCount; ++i) {
+        auto const& rule = binaryRules[i];
+        if (isNullable[rule.right]) {
+            unitRules[unitRuleCount++] = {rule.lhs, rule.left};
+        }
+        if (isNullable[rule.left]) {
+            unitRules[unitRuleCount++] = {rule.lhs, rule.right};
+        }
+    }
+
+    std::array<Nonterminals, _nonterminalCapacity> derivable{};
+    for (size_t nonterminal = 0; nonterminal < nonterminalCount; ++nonterminal) {
+        derivable[nonterminal].set(nonterminal);
+    }
+    for (bool isChanged = true; isChanged;) {
+        isChanged = false;
+        for (size_t i = 0; i < unitRuleCount; ++i) {
+            auto previous = derivable[unitRules[i].lhs];
+            derivable[unitRules[i].lhs] |= derivable[unitRules[i].rhs];
+            isChanged |= !(previous == derivable[unitRules[i].lhs]);
+        }
+    }
+
+    Normalization normalization{};
+    auto& closedBinaryRules = normalization.binaryRules;
+    auto& closedBinaryRuleCount = normalization.binaryRuleCount;
+    auto& closedTerminalRules = normalization.terminalRules;
+    auto& closedTerminalRuleCount = normalization.terminalRuleCount;
+    for (size_t lhs = 0; lhs < nonterminalCount; ++lhs) {
+        auto firstBinaryRule = closedBinaryRuleCount;
+        for (size_t i = 0; i < binaryRuleCount; ++i) {
+            auto const& rule = binaryRules[i];
+            auto isAdded = !derivable[lhs].test(rule.lhs);
+            for (auto j = firstBinaryRule; j < closedBinaryRuleCount && !isAdded; ++j) {
+                auto const& closedRule = closedBinaryRules[j];
+                isAdded = closedRule.left == rule.left && closedRule.right == rule.right;
+            }
+            if (!isAdded) {
+                closedBinaryRules[closedBinaryRuleCount++] = {lhs, rule.left, rule.right};
+            }
+        }
+        auto firstTerminalRule = closedTerminalRuleCount;
+        for (size_t i = 0; i < terminalRuleCount; ++i) {
+            auto const& rule = terminalRules[i];
+            auto isAdded = !derivable[lhs].test(rule.lhs);
+            for (auto j = firstTerminalRule; j < closedTerminalRuleCount && !isAdded; ++j) {
+                isAdded = closedTerminalRules[j].terminal == rule.terminal;
+            }
+            if (!isAdded) {
+                closedTerminalRules[closedTerminalRuleCount++] = {lhs, rule.terminal};
+            }
+        }
+    }
+
+    std::array<bool, _nonterminalCapacity> isProductive{};
+    for (size_t i = 0; i < closedTerminalRuleCount; ++i) {
+        isProductive[closedTerminalRules[i].lhs] = true;
+    }
+    for (bool isChanged = true; isChanged;) {
+        isChanged = false;
+        for (size_t i = 0; i < closedBinaryRuleCount; ++i) {
+            auto const& rule = closedBinaryRules[i];
+            if (!isProductive[rule.lhs] && isProductive[rule.left] && isProductive[rule.right]) {
+                isProductive[rule.lhs] = isChanged = true;
+            }
+        }
+    }
+    std::array<bool, _nonterminalCapacity> isReachable{};
+    isReachable[startSymbol] = true;
+    for (bool isChanged = true; isChanged;) {
+        isChanged = false;
+        for (size_t i = 0; i < closedBinaryRuleCount; ++i) {
+            auto const& rule = closedBinaryRules[i];
+            if (isReachable[rule.lhs] && isProductive[rule.left] && isProductive[rule.right]) {
+                isChanged |= !isReachable[rule.left] || !isReachable[rule.right];
+                isReachable[rule.left] = isReachable[rule.right] = true;
+            }
+        }
+    }
+
+    std::array<size_t, _nonterminalCapacity> indices{};
+    for (size_t nonterminal = 0; nonterminal < nonterminalCount; ++nonterminal) {
+        auto isKept = nonterminal == startSymbol ||
+            (isReachable[nonterminal] && isProductive[nonterminal]);
+        indices[nonterminal] = isKept ? normalization.nonterminalCount++ : noSymbol;
+    }
+    size_t keptRuleCount = 0;
+    for (size_t i = 0; i < closedBinaryRuleCount; ++i) {
+        auto const& rule = closedBinaryRules[i];
+        if (
+            indices[rule.lhs] != noSymbol &&
+            indices[rule.left] != noSymbol &&
+            indices[rule.right] != noSymbol
+        ) {
+            closedBinaryRules[keptRuleCount++] = {
+                indices[rule.lhs],
+                indices[rule.left],
+                indices[rule.right]
+            };
+        }
+    }
+    closedBinaryRuleCount = keptRuleCount;
+    keptRuleCount = 0;
+    for (size_t i = 0; i < closedTerminalRuleCount; ++i) {
+        auto const& rule = closedTerminalRules[i];
+        if (indices[rule.lhs] != noSymbol) {
+            closedTerminalRules[keptRuleCount++] = {indices[rule.lhs], rule.terminal};
+        }
+    }
+    closedTerminalRuleCount = keptRuleCount;
+
+    normalization.startSymbol = indices[startSymbol];
+    normalization.acceptsEmptyWord = isNullable[startSymbol];
+    return normalization;
+}
+
+template<typename Definition>
+template<typename Rule, size_t count, size_t capacity>
+constexpr std::array<Rule, count> StaticGrammar<Definition>::takeRules(
+    std::array<Rule, capacity> const& rules
+) {
+    std::array<Rule, count> takenRules{};
+    for (size_t i = 0; i < count; ++i) {
+        takenRules[i] = rules[i];
+    }
+    return takenRules;
+}
+
+template<typename Definition>
+ContextFreeGrammar StaticGrammar<Definition>::contextFreeGrammar() {
+    Alphabet terminals(Definition::terminals, Definition::terminals + _terminalCount);
+    Alphabet nonterminals(
+        Definition::nonterminals,
+        Definition::nonterminals + _sourceNonterminalCount
+    );
+    std::vector<FL::Grammar::Rule> rules;
+    for (auto const& rule: Definition::rules) {
+        rules.emplace_back(Word{rule.lhs}, Word(rule.rhs, rule.rhs + length(rule.rhs)));
+    }
+    return ContextFreeGrammar(terminals, nonterminals, Definition::startSymbol, rules);
+}
+
+template<typename Definition>
+bool StaticCYK<Definition>::predict(SymbolSequence const& word) {
+    thread_local Workspace workspace;
+    return predict(word, workspace);
+}
+
+template<typename Definition>
+bool StaticCYK<Definition>::predict(SymbolSequence const& word, Workspace& workspace) {
+    auto size = word.size();
+    if (size == 0) {
+        return Grammar::acceptsEmptyWord;
+    }
+
+    workspace.assign(size * size, Bitset());
+    for (size_t i = 0; i < size; ++i) {
+        auto character = word[i].rawValue;
+        if (
+            character < std::numeric_limits<char>::min() ||
+            character > std::numeric_limits<char>::max()
+        ) {
+            return false;
+        }
+        workspace[i] = _terminalMasks[static_cast<unsigned char>(character)];
+        if (!workspace[i].any()) {
+            return false;
+        }
+    }
+
+    for (size_t subwordSize = 2; subwordSize <= size; ++subwordSize) {
+        for (size_t start = 0; start + subwordSize <= size; ++start) {
+            auto& cell = workspace[(subwordSize - 1) * size + start];
+            for (size_t leftSize = 1; leftSize < subwordSize; ++leftSize) {
+                auto const& left = workspace[(leftSize - 1) * size + start];
+                auto const& right = workspace[(subwordSize - leftSize - 1) * size + start + leftSize];
+                if (left.any() && right.any()) {
+                    applyRules(
+                        cell,
+                        left,
+                        right,
+                        std::make_index_sequence<Grammar::binaryRules.size()>()
+                    );
+                }
+            }
+        }
+    }
+    return workspace[(size - 1) * size].test(Grammar::startSymbol);
+}
+
+template<typename Definition>
+constexpr typename StaticCYK<Definition>::TerminalMasks StaticCYK<Definition>::makeTerminalMasks() {
+    TerminalMasks masks{};
+    for (auto const& rule: Grammar::terminalRules) {
+        masks[static_cast<unsigned char>(rule.terminal)].set(rule.lhs);
+    }
+    return masks;
+}
+
+template<typename Definition>
+template<size_t... indices>
+void StaticCYK<Definition>::applyRules(
+    Bitset& cell,
+    Bitset const& left,
+    Bitset const& right,
+    std::index_sequence<indices...>
+) {
+    (applyRule<indices>(cell, left, right), ...);
+}
+
+template<typename Definition>
+template<size_t index>
+void StaticCYK<Definition>::applyRule(Bitset& cell, Bitset const& left, Bitset const& right) {
+    constexpr auto rule = Grammar::binaryRules[index];
+    if (left.test(rule.left) && right.test(rule.right)) {
+        cell.set(rule.lhs);
+    }
+}
+
+}
@@ -0,0 +1,83 @@
+#include "SymbolSequence.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace FL {
+
+SymbolSequence::SymbolSequence(char const* word):
+    _characters(word),
+    _byteSymbols(nullptr),
+    _symbols(nullptr),
+    _size(std::strlen(word))
+{}
+
+SymbolSequence::SymbolSequence(std::string const& word):
+    _characters(word.data()),
+    _byteSymbols(nullptr),
+    _symbols(nullptr),
+    _size(word.size())
+{}
+
+SymbolSequence::SymbolSequence(std::string_view word):
+    _characters(word.data()),
+    _byteSymbols(nullptr),
+    _symbols(nullptr),
+    _size(word.size())
+{}
+
+SymbolSequence::SymbolSequence(Word const& word):
+    _characters(nullptr),
+    _byteSymbols(nullptr),
+    _symbols(word.data()),
+    _size(word.size())
+{}
+
+SymbolSequence::SymbolSequence(Symbol const* symbols, size_t size):
+    _characters(nullptr),
+    _byteSymbols(nullptr),
+    _symbols(symbols),
+    _size(size)
+{}
+
+SymbolSequence::SymbolSequence(void const* bytes, size_t size, Symbol const* byteSymbols):
+    _characters(static_cast<char const*>(bytes)),
+    _byteSymbols(byteSymbols),
+    _symbols(nullptr),
+    _size(size)
+{}
+
+size_t SymbolSequence::size() const {
+    return _size;
+}
+
+bool SymbolSequence::empty() const {
+    return !_size;
+}
+
+Symbol SymbolSequence::operator[](size_t index) const {
+    if (!_characters) {
+        return _symbols[index];
+    }
+    if (_byteSymbols) {
+        return _byteSymbols[static_cast<unsigned char>(_characters[index])];
+    }
+    return _characters[index];
+}
+
+bool SymbolSequence::subwordsAreEqual(
+    size_t firstStart,
+    size_t secondStart,
+    size_t subwordSize
+) const {
+    if (_characters) {
+        return !std::memcmp(_characters + firstStart, _characters + secondStart, subwordSize);
+    }
+    return std::equal(
+        _symbols + firstStart,
+        _symbols + firstStart + subwordSize,
+        _symbols + secondStart
+    );
+}
+
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Common.hpp"
+#include <string>
+#include <string_view>
+
+namespace FL {
+
+class SymbolSequence {
+public:
+    SymbolSequence(char const* word);
+    SymbolSequence(std::string const& word);
+    SymbolSequence(std::string_view word);
+    SymbolSequence(Word const& word);
+    SymbolSequence(Symbol const* symbols, size_t size);
+    SymbolSequence(void const* bytes, size_t size, Symbol const* byteSymbols);
+
+    size_t size() const;
+    bool empty() const;
+    Symbol operator[](size_t index) const;
+    bool subwordsAreEqual(size_t firstStart, size_t secondStart, size_t subwordSize) const;
+
+protected:
+    char const* _characters;
+    Symbol const* _byteSymbols;
+    Symbol const* _symbols;
+    size_t _size;
+};
+
+}
@@ -0,0 +1,59 @@
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+
+namespace FL {
+
+ThreadPool::ThreadPool(size_t threadCount):
+    _isStopping(false)
+{
+    if (!threadCount) {
+        threadCount = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    for (size_t i = 0; i < threadCount; ++i) {
+        _threads.emplace_back(&ThreadPool::work, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _isStopping = true;
+    }
+    _condition.notify_all();
+    for (auto& thread: _threads) {
+        thread.join();
+    }
+}
+
+size_t ThreadPool::threadCount() const {
+    return _threads.size();
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _tasks.push_back(std::move(task));
+    }
+    _condition.notify_one();
+}
+
+void ThreadPool::work() {
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _condition.wait(lock, [this] {
+                return _isStopping || !_tasks.empty();
+            });
+            if (_tasks.empty()) {
+                return;
+            }
+            task = std::move(_tasks.front());
+            _tasks.pop_front();
+        }
+        task();
+    }
+}
+
+}
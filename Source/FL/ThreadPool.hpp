@@ -0,0 +1,33 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace FL {
+
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t threadCount = 0);
+    ThreadPool(ThreadPool const&) = delete;
+    ~ThreadPool();
+
+    ThreadPool& operator=(ThreadPool const&) = delete;
+
+    size_t threadCount() const;
+    void submit(std::function<void()> task);
+
+protected:
+    void work();
+
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    std::deque<std::function<void()>> _tasks;
+    bool _isStopping;
+    std::vector<std::thread> _threads;
+};
+
+}
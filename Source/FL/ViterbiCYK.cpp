@@ -0,0 +1,74 @@
+#include "ViterbiCYK.hpp"
+
+#include <algorithm>
+
+namespace FL {
+
+ViterbiCYK::ViterbiCYK(
+    ContextFreeGrammar const& grammar,
+    ViterbiOptions const& viterbiOptions,
+    CYKOptions const& options
+):
+    SemiringCYK(grammar, options),
+    _viterbiOptions(viterbiOptions)
+{}
+
+ViterbiOptions const& ViterbiCYK::viterbiOptions() const {
+    return _viterbiOptions;
+}
+
+ViterbiCYK::Value ViterbiCYK::evaluate(SymbolSequence const& word) const {
+    return logProbability(word);
+}
+
+ViterbiCYK::Value ViterbiCYK::evaluate(SymbolSequence const& word, Workspace& workspace) const {
+    return logProbability(word, workspace);
+}
+
+float ViterbiCYK::logProbability(SymbolSequence const& word) const {
+    thread_local Workspace workspace;
+    return logProbability(word, workspace);
+}
+
+float ViterbiCYK::logProbability(SymbolSequence const& word, Workspace& workspace) const {
+    if (word.empty()) {
+        return _emptyWordValue;
+    }
+
+    auto table = calculateTableValues(word, workspace);
+    return table.cell(0, word.size() - 1)[_startIndex];
+}
+
+void ViterbiCYK::pruneSubwordValues(
+    ValueTable const& table,
+    size_t subwordStart,
+    size_t subwordEnd
+) const {
+    auto values = table.cell(subwordStart, subwordEnd);
+    auto bestValue = *std::max_element(values, values + _nonterminals.size());
+    auto minValue = std::max(_viterbiOptions.threshold, bestValue - _viterbiOptions.beamWidth);
+    for (size_t i = 0; i < _nonterminals.size(); ++i) {
+        if (values[i] < minValue) {
+            values[i] = ViterbiSemiring::zero();
+        }
+    }
+}
+
+ViterbiCYK::ValueTable ViterbiCYK::calculateTableValues(
+    SymbolSequence const& word,
+    Workspace& workspace
+) const {
+    auto table = initTable(word, workspace);
+    for (size_t subwordSize = 1; subwordSize <= word.size(); ++subwordSize) {
+        for (size_t subwordStart = 0; subwordStart + subwordSize <= word.size(); ++subwordStart) {
+            if (subwordSize > 1) {
+                calculateSubwordValues(table, subwordStart, subwordSize);
+            }
+            pruneSubwordValues(table, subwordStart, subwordStart + subwordSize - 1);
+        }
+    }
+
+    return table;
+}
+
+}
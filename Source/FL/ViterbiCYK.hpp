@@ -0,0 +1,34 @@
+#pragma once
+
+#include "SemiringCYK.hpp"
+#include <limits>
+
+namespace FL {
+
+struct ViterbiOptions {
+    float beamWidth = std::numeric_limits<float>::infinity();
+    float threshold = -std::numeric_limits<float>::infinity();
+};
+
+class ViterbiCYK: public SemiringCYK<ViterbiSemiring> {
+public:
+    explicit ViterbiCYK(
+        ContextFreeGrammar const& grammar,
+        ViterbiOptions const& viterbiOptions = {},
+        CYKOptions const& options = {}
+    );
+
+    ViterbiOptions const& viterbiOptions() const;
+    Value evaluate(SymbolSequence const& word) const;
+    Value evaluate(SymbolSequence const& word, Workspace& workspace) const;
+    float logProbability(SymbolSequence const& word) const;
+    float logProbability(SymbolSequence const& word, Workspace& workspace) const;
+
+protected:
+    void pruneSubwordValues(ValueTable const& table, size_t subwordStart, size_t subwordEnd) const;
+    ValueTable calculateTableValues(SymbolSequence const& word, Workspace& workspace) const;
+
+    ViterbiOptions _viterbiOptions;
+};
+
+}
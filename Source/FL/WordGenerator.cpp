@@ -0,0 +1,430 @@
+#include "WordGenerator.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace FL {
+
+namespace {
+
+double const noDerivations = -std::numeric_limits<double>::infinity();
+size_t const maxMutationAttempts = 16;
+
+double uniformUnit(WordGenerator::Random& random) {
+    return static_cast<double>(random() >> 11) * 0x1.0p-53;
+}
+
+char byteTerminal(Symbol terminal) {
+    if (terminal.rawValue < std::numeric_limits<char>::min() || terminal.rawValue > 255) {
+        throw NonByteAlphabetException();
+    }
+    return static_cast<char>(terminal.rawValue);
+}
+
+}
+
+WordGenerator::WordGenerator(ContextFreeGrammar const& grammar, size_t maxWordSize):
+    _maxWordSize(maxWordSize),
+    _acceptsEmptyWord(false)
+{
+    for (auto terminal: grammar.terminals()) {
+        _alphabet += byteTerminal(terminal);
+    }
+    std::sort(_alphabet.begin(), _alphabet.end());
+
+    auto normalizedGrammar = grammar.normalized();
+    std::vector<Symbol> nonterminals(
+        normalizedGrammar.nonterminals().begin(),
+        normalizedGrammar.nonterminals().end()
+    );
+    std::sort(nonterminals.begin(), nonterminals.end(), [](Symbol lhs, Symbol rhs) {
+        return lhs.rawValue < rhs.rawValue;
+    });
+    std::unordered_map<Symbol, size_t> nonterminalIndices;
+    for (size_t i = 0; i < nonterminals.size(); ++i) {
+        nonterminalIndices[nonterminals[i]] = i;
+    }
+    _nonterminalCount = nonterminals.size();
+    _startIndex = nonterminalIndices.at(normalizedGrammar.startSymbol());
+
+    _terminals.resize(_nonterminalCount);
+    std::vector<std::vector<std::pair<size_t, size_t>>> rules(_nonterminalCount);
+    for (auto const& [lhs, rhs]: normalizedGrammar.rules()) {
+        auto parent = nonterminalIndices.at(lhs[0]);
+        if (rhs.empty()) {
+            _acceptsEmptyWord |= parent == _startIndex;
+        } else if (rhs.size() == 1 && normalizedGrammar.symbolIsTerminal(rhs[0])) {
+            _terminals[parent] += byteTerminal(rhs[0]);
+        } else if (rhs.size() == 2) {
+            rules[parent].emplace_back(
+                nonterminalIndices.at(rhs[0]),
+                nonterminalIndices.at(rhs[1])
+            );
+        }
+    }
+    for (auto& terminals: _terminals) {
+        std::sort(terminals.begin(), terminals.end());
+        terminals.erase(std::unique(terminals.begin(), terminals.end()), terminals.end());
+    }
+    for (auto& nonterminalRules: rules) {
+        std::sort(nonterminalRules.begin(), nonterminalRules.end());
+        nonterminalRules.erase(
+            std::unique(nonterminalRules.begin(), nonterminalRules.end()),
+            nonterminalRules.end()
+        );
+    }
+
+    countDerivations(rules);
+}
+
+size_t WordGenerator::maxWordSize() const {
+    return _maxWordSize;
+}
+
+std::string const& WordGenerator::alphabet() const {
+    return _alphabet;
+}
+
+bool WordGenerator::hasWords(size_t size) const {
+    return logDerivationCount(size) != noDerivations;
+}
+
+double WordGenerator::logDerivationCount(size_t size) const {
+    if (size == 0) {
+        return _acceptsEmptyWord ? 0 : noDerivations;
+    }
+    if (size > _maxWordSize) {
+        return noDerivations;
+    }
+    return _logCounts[tableIndex(_startIndex, size)];
+}
+
+std::string WordGenerator::generate(size_t size, Random& random) const {
+    std::string word;
+    generate(size, random, word);
+    return word;
+}
+
+void WordGenerator::generate(size_t size, Random& random, std::string& word) const {
+    if (!hasWords(size)) {
+        throw NoWordsOfSizeException();
+    }
+    word.resize(size);
+    if (size == 0) {
+        return;
+    }
+
+    thread_local std::vector<Node> nodes;
+    nodes.assign(1, {
+        static_cast<std::uint32_t>(_startIndex),
+        0,
+        static_cast<std::uint32_t>(size)
+    });
+    while (!nodes.empty()) {
+        auto node = nodes.back();
+        nodes.pop_back();
+        if (node.size == 1) {
+            auto const& terminals = _terminals[node.nonterminal];
+            word[node.start] = terminals[terminals.size() == 1 ? 0 : random() % terminals.size()];
+            continue;
+        }
+
+        auto index = tableIndex(node.nonterminal, node.size);
+        auto begin = _choices.begin() + _choiceOffsets[index];
+        auto end = _choices.begin() + _choiceOffsets[index + 1];
+        auto choice = std::upper_bound(
+            begin,
+            end,
+            uniformUnit(random),
+            [](double value, Choice const& choice) {
+                return value < choice.cumulativeWeight;
+            }
+        );
+        if (choice == end) {
+            --choice;
+        }
+        nodes.push_back({
+            choice->rightChild,
+            node.start + choice->leftSize,
+            node.size - choice->leftSize
+        });
+        nodes.push_back({choice->leftChild, node.start, choice->leftSize});
+    }
+}
+
+void WordGenerator::mutate(std::string& word, Random& random) const {
+    if (word.empty()) {
+        applyMutation(word, Mutation::Insertion, random);
+    } else {
+        applyMutation(word, static_cast<Mutation>(random() % 4), random);
+    }
+}
+
+void WordGenerator::generateNearMiss(size_t size, Random& random, std::string& word) const {
+    std::vector<std::pair<Mutation, size_t>> mutations;
+    if (size > 0 && _alphabet.size() > 1 && hasWords(size)) {
+        mutations.emplace_back(Mutation::Substitution, size);
+        mutations.emplace_back(Mutation::Transposition, size);
+    }
+    if (size > 0 && hasWords(size - 1)) {
+        mutations.emplace_back(Mutation::Insertion, size - 1);
+    }
+    if (hasWords(size + 1)) {
+        mutations.emplace_back(Mutation::Deletion, size + 1);
+    }
+    if (mutations.empty() || _alphabet.empty()) {
+        throw NoWordsOfSizeException();
+    }
+
+    auto [mutation, baseSize] = mutations[random() % mutations.size()];
+    generate(baseSize, random, word);
+    applyMutation(word, mutation, random);
+}
+
+CorpusReport WordGenerator::writeCorpus(
+    std::ostream& output,
+    CorpusOptions const& options,
+    CYK const* verifier
+) const {
+    auto startTime = std::chrono::steady_clock::now();
+    std::vector<size_t> sizes;
+    for (auto size = options.minWordSize; size <= options.maxWordSize; ++size) {
+        if (hasWords(size)) {
+            sizes.push_back(size);
+        }
+    }
+    if (sizes.empty()) {
+        throw NoWordsOfSizeException();
+    }
+    if (options.writesLabels && options.negativeRatio > 0 && !verifier) {
+        throw UnverifiedLabelsException();
+    }
+
+    auto threadCount = options.threadCount ?
+        options.threadCount :
+        std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    auto wordsPerChunk = std::max<size_t>(options.wordsPerChunk, 1);
+    auto chunkCount = (options.wordCount + wordsPerChunk - 1) / wordsPerChunk;
+    std::vector<std::string> texts(threadCount * 4);
+    std::vector<CorpusReport> reports(texts.size());
+
+    CorpusReport report;
+    for (size_t firstChunk = 0; firstChunk < chunkCount; firstChunk += texts.size()) {
+        auto roundChunkCount = std::min(texts.size(), chunkCount - firstChunk);
+        std::atomic<size_t> nextChunk{0};
+        std::exception_ptr exception;
+        std::mutex exceptionMutex;
+        auto work = [&]() {
+            try {
+                for (size_t i; (i = nextChunk++) < roundChunkCount;) {
+                    auto chunk = firstChunk + i;
+                    auto wordCount = std::min(
+                        wordsPerChunk,
+                        options.wordCount - chunk * wordsPerChunk
+                    );
+                    reports[i] = {};
+                    generateChunk(texts[i], options, sizes, chunk, wordCount, verifier, reports[i]);
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(exceptionMutex);
+                exception = std::current_exception();
+            }
+        };
+        std::vector<std::thread> threads;
+        for (size_t i = 1; i < std::min(threadCount, roundChunkCount); ++i) {
+            threads.emplace_back(work);
+        }
+        work();
+        for (auto& thread: threads) {
+            thread.join();
+        }
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+
+        for (size_t i = 0; i < roundChunkCount; ++i) {
+            output.write(texts[i].data(), texts[i].size());
+            report.wordCount += reports[i].wordCount;
+            report.negativeCount += reports[i].negativeCount;
+            report.rejectedMutationCount += reports[i].rejectedMutationCount;
+            report.byteCount += texts[i].size();
+        }
+    }
+
+    report.seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - startTime
+    ).count();
+    return report;
+}
+
+size_t WordGenerator::tableIndex(size_t nonterminal, size_t size) const {
+    return size * _nonterminalCount + nonterminal;
+}
+
+char WordGenerator::randomTerminal(Random& random) const {
+    return _alphabet[random() % _alphabet.size()];
+}
+
+void WordGenerator::applyMutation(std::string& word, Mutation mutation, Random& random) const {
+    if (_alphabet.empty()) {
+        return;
+    }
+    if (word.empty()) {
+        mutation = Mutation::Insertion;
+    }
+
+    auto position = random() % std::max<size_t>(word.size(), 1);
+    if (mutation == Mutation::Transposition) {
+        if (word.size() > 1 && position + 1 == word.size()) {
+            --position;
+        }
+        if (position + 1 < word.size() && word[position] != word[position + 1]) {
+            std::swap(word[position], word[position + 1]);
+            return;
+        }
+        mutation = Mutation::Substitution;
+    }
+
+    switch (mutation) {
+    case Mutation::Substitution: {
+        auto index = random() % _alphabet.size();
+        if (_alphabet[index] == word[position]) {
+            index = (index + 1) % _alphabet.size();
+        }
+        word[position] = _alphabet[index];
+        break;
+    }
+    case Mutation::Insertion:
+        word.insert(word.begin() + random() % (word.size() + 1), randomTerminal(random));
+        break;
+    default:
+        word.erase(word.begin() + position);
+        break;
+    }
+}
+
+void WordGenerator::countDerivations(
+    std::vector<std::vector<std::pair<size_t, size_t>>> const& rules
+) {
+    auto tableSize = (_maxWordSize + 1) * _nonterminalCount;
+    _logCounts.assign(tableSize, noDerivations);
+    _choiceOffsets.assign(tableSize + 1, 0);
+    _choices.clear();
+
+    std::vector<Choice> choices;
+    std::vector<double> logWeights;
+    for (size_t size = 1; size <= _maxWordSize; ++size) {
+        for (size_t nonterminal = 0; nonterminal < _nonterminalCount; ++nonterminal) {
+            auto index = tableIndex(nonterminal, size);
+            _choiceOffsets[index] = _choices.size();
+            if (size == 1) {
+                if (!_terminals[nonterminal].empty()) {
+                    _logCounts[index] = std::log(static_cast<double>(_terminals[nonterminal].size()));
+                }
+                continue;
+            }
+
+            choices.clear();
+            logWeights.clear();
+            for (auto [leftChild, rightChild]: rules[nonterminal]) {
+                for (size_t leftSize = 1; leftSize < size; ++leftSize) {
+                    auto logWeight = _logCounts[tableIndex(leftChild, leftSize)] +
+                        _logCounts[tableIndex(rightChild, size - leftSize)];
+                    if (logWeight != noDerivations) {
+                        choices.push_back({
+                            0,
+                            static_cast<std::uint32_t>(leftChild),
+                            static_cast<std::uint32_t>(rightChild),
+                            static_cast<std::uint32_t>(leftSize)
+                        });
+                        logWeights.push_back(logWeight);
+                    }
+                }
+            }
+            if (choices.empty()) {
+                continue;
+            }
+
+            auto maxLogWeight = *std::max_element(logWeights.begin(), logWeights.end());
+            double totalWeight = 0;
+            for (size_t i = 0; i < choices.size(); ++i) {
+                totalWeight += std::exp(logWeights[i] - maxLogWeight);
+                choices[i].cumulativeWeight = totalWeight;
+            }
+            for (auto& choice: choices) {
+                choice.cumulativeWeight /= totalWeight;
+            }
+            _logCounts[index] = maxLogWeight + std::log(totalWeight);
+            _choices.insert(_choices.end(), choices.begin(), choices.end());
+        }
+    }
+    _choiceOffsets.back() = _choices.size();
+}
+
+void WordGenerator::generateChunk(
+    std::string& text,
+    CorpusOptions const& options,
+    std::vector<size_t> const& sizes,
+    std::uint64_t chunkSeed,
+    size_t wordCount,
+    CYK const* verifier,
+    CorpusReport& report
+) const {
+    std::seed_seq seed{
+        static_cast<std::uint32_t>(options.seed),
+        static_cast<std::uint32_t>(options.seed >> 32),
+        static_cast<std::uint32_t>(chunkSeed),
+        static_cast<std::uint32_t>(chunkSeed >> 32)
+    };
+    Random random(seed);
+    CYK::Workspace workspace;
+    std::string word;
+    text.clear();
+    for (size_t i = 0; i < wordCount; ++i) {
+        auto size = sizes[random() % sizes.size()];
+        auto isNegative = options.negativeRatio > 0 && uniformUnit(random) < options.negativeRatio;
+        if (isNegative) {
+            size_t attempt = 0;
+            for (; attempt < maxMutationAttempts; ++attempt) {
+                generateNearMiss(size, random, word);
+                if (!verifier || !verifier->predict(word, workspace)) {
+                    break;
+                }
+                ++report.rejectedMutationCount;
+            }
+            if (attempt == maxMutationAttempts) {
+                continue;
+            }
+            ++report.negativeCount;
+        } else {
+            generate(size, random, word);
+        }
+
+        text += word;
+        if (options.writesLabels) {
+            text += isNegative ? "\t0" : "\t1";
+        }
+        text += '\n';
+        ++report.wordCount;
+    }
+}
+
+char const* NoWordsOfSizeException::what() const throw() {
+    return "Grammar generates no words of this size";
+}
+
+char const* NonByteAlphabetException::what() const throw() {
+    return "Word generation only supports single-byte terminals";
+}
+
+char const* UnverifiedLabelsException::what() const throw() {
+    return "Labelled corpora with negative words need a verifying recognizer";
+}
+
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "ContextFreeGrammar.hpp"
+#include "CYK.hpp"
+#include <ostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <exception>
+
+namespace FL {
+
+struct CorpusOptions {
+    size_t wordCount = 0;
+    size_t minWordSize = 0;
+    size_t maxWordSize = 0;
+    double negativeRatio = 0;
+    bool writesLabels = false;
+    size_t threadCount = 0;
+    std::uint64_t seed = 0;
+    size_t wordsPerChunk = 16 * 1024;
+};
+
+struct CorpusReport {
+    size_t wordCount = 0;
+    size_t negativeCount = 0;
+    size_t rejectedMutationCount = 0;
+    size_t byteCount = 0;
+    double seconds = 0;
+};
+
+class WordGenerator {
+public:
+    using Random = std::mt19937_64;
+
+    WordGenerator(ContextFreeGrammar const& grammar, size_t maxWordSize);
+
+    size_t maxWordSize() const;
+    std::string const& alphabet() const;
+    bool hasWords(size_t size) const;
+    double logDerivationCount(size_t size) const;
+
+    std::string generate(size_t size, Random& random) const;
+    void generate(size_t size, Random& random, std::string& word) const;
+    void mutate(std::string& word, Random& random) const;
+    void generateNearMiss(size_t size, Random& random, std::string& word) const;
+
+    CorpusReport writeCorpus(
+        std::ostream& output,
+        CorpusOptions const& options,
+        CYK const* verifier = nullptr
+    ) const;
+
+protected:
+    enum class Mutation {
+        Substitution,
+        Insertion,
+        Deletion,
+        Transposition
+    };
+
+    struct Choice {
+        double cumulativeWeight;
+        std::uint32_t leftChild;
+        std::uint32_t rightChild;
+        std::uint32_t leftSize;
+    };
+
+    struct Node {
+        std::uint32_t nonterminal;
+        std::uint32_t start;
+        std::uint32_t size;
+    };
+
+    size_t tableIndex(size_t nonterminal, size_t size) const;
+    char randomTerminal(Random& random) const;
+    void applyMutation(std::string& word, Mutation mutation, Random& random) const;
+    void countDerivations(std::vector<std::vector<std::pair<size_t, size_t>>> const& rules);
+    void generateChunk(
+        std::string& text,
+        CorpusOptions const& options,
+        std::vector<size_t> const& sizes,
+        std::uint64_t chunkSeed,
+        size_t wordCount,
+        CYK const* verifier,
+        CorpusReport& report
+    ) const;
+
+    size_t _maxWordSize;
+    size_t _nonterminalCount;
+    size_t _startIndex;
+    bool _acceptsEmptyWord;
+    std::string _alphabet;
+    std::vector<std::string> _terminals;
+    std::vector<double> _logCounts;
+    std::vector<size_t> _choiceOffsets;
+    std::vector<Choice> _choices;
+};
+
+struct NoWordsOfSizeException: std::exception {
+    char const* what() const throw();
+};
+
+struct NonByteAlphabetException: std::exception {
+    char const* what() const throw();
+};
+
+struct UnverifiedLabelsException: std::exception {
+    char const* what() const throw();
+};
+
+}
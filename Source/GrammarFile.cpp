@@ -0,0 +1,68 @@
+#include "GrammarFile.hpp"
+
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+#include <FL/GrammarLoader.hpp>
+
+namespace FL {
+
+ContextFreeGrammar readGrammar(std::istream& input, std::ostream* prompts) {
+    if (prompts) {
+        *prompts << "Terminals: ";
+    }
+    Alphabet terminals;
+    char symbol;
+    while (input >> symbol && symbol != inputSeparator) {
+        terminals.insert(symbol);
+    }
+
+    if (prompts) {
+        *prompts << "Nonterminals: ";
+    }
+    Alphabet nonterminals;
+    while (input >> symbol && symbol != inputSeparator) {
+        nonterminals.insert(symbol);
+    }
+
+    if (prompts) {
+        *prompts << "Start symbol: ";
+    }
+    input >> symbol;
+    Symbol startSymbol = symbol;
+
+    if (prompts) {
+        *prompts << "Rules (lhs[space]rhs|<eps>): ";
+    }
+    std::string lhs;
+    std::string rhs;
+    std::vector<Grammar::Rule> rules;
+    while (input >> lhs && lhs != std::string(1, inputSeparator)) {
+        input >> rhs;
+        if (rhs == "<eps>") {
+            rhs.clear();
+        }
+        rules.emplace_back(lhs, rhs);
+    }
+
+    return ContextFreeGrammar(terminals, nonterminals, startSymbol, rules);
+}
+
+bool isBNFPath(std::string const& path) {
+    std::string const extension = ".bnf";
+    return path.size() >= extension.size() &&
+        path.compare(path.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+ContextFreeGrammar loadGrammar(std::string const& path) {
+    if (isBNFPath(path)) {
+        return GrammarLoader::load(path).grammar();
+    }
+    std::ifstream file(path);
+    if (!file) {
+        throw std::runtime_error("Could not open " + path);
+    }
+    return readGrammar(file, nullptr);
+}
+
+}
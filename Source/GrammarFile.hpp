@@ -0,0 +1,15 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <FL/ContextFreeGrammar.hpp>
+
+namespace FL {
+
+char const inputSeparator = '^';
+
+ContextFreeGrammar readGrammar(std::istream& input, std::ostream* prompts);
+bool isBNFPath(std::string const& path);
+ContextFreeGrammar loadGrammar(std::string const& path);
+
+}
@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+
+#include <FL/ContextFreeGrammar.hpp>
+#include <FL/BatchRecognizer.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace FL;
+
+TEST(BatchRecognizer, Run) {
+    ContextFreeGrammar grammar(
+        {'(', ')'},
+        {'S'},
+        'S',
+        {{"S", "SS"}, {"S", "()"}, {"S", "(S)"}, {"S", ""}}
+    );
+    CYK cyk(grammar);
+
+    std::vector<std::string> words{"()", "", "(()", std::string(40, '(') + std::string(40, ')')};
+    for (size_t i = 0; i < 200; ++i) {
+        words.push_back(std::string(i % 7, '(') + std::string(i % 5, ')'));
+    }
+    std::string text;
+    std::vector<std::uint8_t> expectedResults;
+    for (size_t i = 0; i < words.size(); ++i) {
+        text += words[i] + (i % 3 ? "\n" : "\r\n");
+        expectedResults.push_back(cyk.predict(words[i]));
+    }
+    text += "()()";
+    expectedResults.push_back(true);
+
+    for (size_t threadCount: {1, 3}) {
+        for (size_t chunkSize: {1, 16, 4096}) {
+            BatchRecognizer recognizer(cyk, {threadCount, chunkSize, 2});
+            std::istringstream input(text);
+            std::vector<std::uint8_t> results;
+            auto report = recognizer.run(input, [&results](auto const& chunkResults) {
+                results.insert(results.end(), chunkResults.begin(), chunkResults.end());
+            });
+            EXPECT_EQ(results, expectedResults);
+            EXPECT_EQ(report.wordCount, expectedResults.size());
+            EXPECT_EQ(report.byteCount, text.size());
+            EXPECT_EQ(report.latencies.count(), expectedResults.size());
+            EXPECT_EQ(
+                report.acceptedCount,
+                std::count(expectedResults.begin(), expectedResults.end(), 1)
+            );
+        }
+    }
+
+    std::istringstream emptyInput;
+    EXPECT_EQ(BatchRecognizer(cyk).run(emptyInput, nullptr).wordCount, 0);
+}
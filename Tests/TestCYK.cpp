@@ -2,6 +2,7 @@
 
 #include <FL/ContextFreeGrammar.hpp>
 #include <FL/CYK.hpp>
+#include <algorithm>
 #include <vector>
 #include <tuple>
 
@@ -11,12 +12,24 @@ struct CYKPrivate: public CYK {
     using CYK::CYK;
     using CYK::predict;
     using CYK::acceptsEmptyWord;
-    using CYK::findDirectChildren;
+    using CYK::generatesSubword;
     using CYK::initTable;
-    using CYK::checkIfNonterminalGeneratesSubword;
+    using CYK::calculateSubwordValues;
+    using CYK::calculatePrefixHashes;
+    using CYK::findEqualSubwords;
     using CYK::calculateTableValues;
 };
 
+namespace {
+
+CYKOptions memoizingOptions() {
+    CYKOptions options;
+    options.memoizeRepeatedSubwords = true;
+    return options;
+}
+
+}
+
 TEST(CYK, EmptyWord) {
     ContextFreeGrammar grammar({'a'}, {'A'}, 'A', {{"A", "a"}});
     CYK cyk(grammar);
@@ -31,7 +44,8 @@ TEST(CYK, TableCreation) {
     ContextFreeGrammar grammar({'(', ')'}, {'S'}, 'S', {{"S", "SS"}, {"S", ""}, {"S", "(S)"}});
     CYKPrivate cyk(grammar);
     std::string word = "(())()()(((())()()))()((())()())()((()()))()()";
-    auto table = cyk.calculateTableValues(word);
+    CYK::Workspace workspace;
+    auto table = cyk.calculateTableValues(word, workspace);
 
     auto shouldAcceptWord = [&](size_t subwordStart, size_t subwordEnd) {
         int balance = 0;
@@ -51,7 +65,7 @@ TEST(CYK, TableCreation) {
     for (size_t subwordStart = 0; subwordStart < word.size(); ++subwordStart) {
         for (size_t subwordEnd = subwordStart; subwordEnd < word.size(); ++subwordEnd) {
             EXPECT_EQ(
-                table[cyk.grammar().startSymbol()][subwordStart][subwordEnd],
+                cyk.generatesSubword(table, cyk.grammar().startSymbol(), subwordStart, subwordEnd),
                 shouldAcceptWord(subwordStart, subwordEnd)
             );
         }
@@ -61,3 +75,268 @@ TEST(CYK, TableCreation) {
     word.pop_back();
     EXPECT_FALSE(cyk.predict(word));
 }
+
+TEST(CYK, RepeatedSubwordMemoization) {
+    ContextFreeGrammar grammar({'(', ')'}, {'S'}, 'S', {{"S", "SS"}, {"S", ""}, {"S", "(S)"}});
+    CYKPrivate cyk(grammar);
+    CYKPrivate memoizingCYK(grammar, memoizingOptions());
+    EXPECT_TRUE(memoizingCYK.options().memoizeRepeatedSubwords);
+
+    std::string word = "(()())(()())(()())((()())(()())(()()))(()())";
+    CYK::Workspace workspace;
+    memoizingCYK.calculatePrefixHashes(word, workspace);
+    auto equalSubwords = memoizingCYK.findEqualSubwords(word, workspace, 6);
+    for (size_t subwordStart = 0; subwordStart + 6 <= word.size(); ++subwordStart) {
+        EXPECT_LE(equalSubwords[subwordStart], subwordStart);
+        EXPECT_EQ(word.substr(equalSubwords[subwordStart], 6), word.substr(subwordStart, 6));
+    }
+    EXPECT_EQ(equalSubwords[6], 0);
+    EXPECT_EQ(equalSubwords[12], 0);
+
+    CYK::Workspace memoizingWorkspace;
+    auto table = cyk.calculateTableValues(word, workspace);
+    auto memoizedTable = memoizingCYK.calculateTableValues(word, memoizingWorkspace);
+    for (auto nonterminal: cyk.grammar().nonterminals()) {
+        for (size_t subwordStart = 0; subwordStart < word.size(); ++subwordStart) {
+            for (size_t subwordEnd = subwordStart; subwordEnd < word.size(); ++subwordEnd) {
+                EXPECT_EQ(
+                    cyk.generatesSubword(table, nonterminal, subwordStart, subwordEnd),
+                    memoizingCYK.generatesSubword(
+                        memoizedTable,
+                        nonterminal,
+                        subwordStart,
+                        subwordEnd
+                    )
+                );
+            }
+        }
+    }
+
+    EXPECT_TRUE(memoizingCYK.predict(word));
+    word.pop_back();
+    EXPECT_FALSE(memoizingCYK.predict(word));
+}
+
+TEST(CYK, WorkspaceReuse) {
+    ContextFreeGrammar grammar({'(', ')'}, {'S'}, 'S', {{"S", "SS"}, {"S", ""}, {"S", "(S)"}});
+    CYK cyk(grammar);
+    CYK memoizingCYK(grammar, memoizingOptions());
+    CYK::Workspace workspace;
+    EXPECT_EQ(workspace.allocationCount(), 0);
+    EXPECT_EQ(workspace.capacity(), 0);
+
+    std::string longWord = "(()())(()())(()())((()())(()())(()()))(()())";
+    EXPECT_TRUE(cyk.predict(longWord, workspace));
+    EXPECT_TRUE(memoizingCYK.predict(longWord, workspace));
+    auto allocationCount = workspace.allocationCount();
+    auto capacity = workspace.capacity();
+    EXPECT_GT(allocationCount, 0);
+    EXPECT_GT(capacity, 0);
+
+    for (auto const& word: {"()", "(()", longWord.c_str(), "(()())((", "()()()()()"}) {
+        cyk.predict(word, workspace);
+        memoizingCYK.predict(word, workspace);
+    }
+    EXPECT_EQ(workspace.allocationCount(), allocationCount);
+    EXPECT_EQ(workspace.capacity(), capacity);
+
+    EXPECT_TRUE(cyk.predict(longWord + "()", workspace));
+    EXPECT_GT(workspace.allocationCount(), allocationCount);
+}
+
+TEST(CYK, TriangularTiledLayout) {
+    ContextFreeGrammar grammar({'(', ')'}, {'S'}, 'S', {{"S", "SS"}, {"S", ""}, {"S", "(S)"}});
+    CYKPrivate cyk(grammar);
+    std::string word = "(())()()(((())()()))()((())()())()((()()))()()(()(()))";
+    CYK::Workspace workspace;
+    auto table = cyk.calculateTableValues(word, workspace);
+    auto squareCapacity = workspace.capacity();
+
+    for (size_t tileSize: {0, 1, 3, 8, 64}) {
+        for (bool memoizeRepeatedSubwords: {false, true}) {
+            CYKOptions options;
+            options.memoizeRepeatedSubwords = memoizeRepeatedSubwords;
+            options.layout = ChartLayout::TriangularTiled;
+            options.tileSize = tileSize;
+            CYKPrivate tiledCYK(grammar, options);
+            CYK::Workspace tiledWorkspace;
+            auto tiledTable = tiledCYK.calculateTableValues(word, tiledWorkspace);
+            if (tileSize == 1 && !memoizeRepeatedSubwords) {
+                EXPECT_LT(
+                    tiledWorkspace.capacity(),
+                    squareCapacity / 2 + 2 * word.size() * sizeof(std::ptrdiff_t)
+                );
+            }
+
+            for (auto nonterminal: cyk.grammar().nonterminals()) {
+                for (size_t subwordStart = 0; subwordStart < word.size(); ++subwordStart) {
+                    for (size_t subwordEnd = subwordStart; subwordEnd < word.size(); ++subwordEnd) {
+                        EXPECT_EQ(
+                            cyk.generatesSubword(table, nonterminal, subwordStart, subwordEnd),
+                            tiledCYK.generatesSubword(
+                                tiledTable,
+                                nonterminal,
+                                subwordStart,
+                                subwordEnd
+                            )
+                        );
+                    }
+                }
+            }
+
+            EXPECT_TRUE(tiledCYK.predict(word));
+            EXPECT_FALSE(tiledCYK.predict(word + "("));
+        }
+    }
+}
+
+TEST(CYK, OutOfCoreChart) {
+    ContextFreeGrammar grammar({'(', ')'}, {'S'}, 'S', {{"S", "SS"}, {"S", ""}, {"S", "(S)"}});
+    CYKPrivate cyk(grammar);
+    std::string word = "(())()()(((())()()))()((())()())()((()()))()()(()(()))";
+    CYK::Workspace workspace;
+    auto table = cyk.calculateTableValues(word, workspace);
+
+    std::vector<size_t> capacities;
+    for (auto [layout, memoizeRepeatedSubwords]: {
+        std::pair{ChartLayout::Square, false},
+        std::pair{ChartLayout::Square, true},
+        std::pair{ChartLayout::TriangularTiled, false}
+    }) {
+        CYKOptions options;
+        options.layout = layout;
+        options.memoizeRepeatedSubwords = memoizeRepeatedSubwords;
+        options.tileSize = 4;
+        options.maxInMemoryChartSize = 1;
+        CYKPrivate outOfCoreCYK(grammar, options);
+        CYK::Workspace outOfCoreWorkspace;
+        auto outOfCoreTable = outOfCoreCYK.calculateTableValues(word, outOfCoreWorkspace);
+
+        for (size_t subwordStart = 0; subwordStart < word.size(); ++subwordStart) {
+            for (size_t subwordEnd = subwordStart; subwordEnd < word.size(); ++subwordEnd) {
+                EXPECT_EQ(
+                    cyk.generatesSubword(table, grammar.startSymbol(), subwordStart, subwordEnd),
+                    outOfCoreCYK.generatesSubword(
+                        outOfCoreTable,
+                        outOfCoreCYK.grammar().startSymbol(),
+                        subwordStart,
+                        subwordEnd
+                    )
+                );
+            }
+        }
+
+        capacities.push_back(outOfCoreWorkspace.capacity());
+        EXPECT_FALSE(outOfCoreCYK.predict(word + ")", outOfCoreWorkspace));
+        auto allocationCount = outOfCoreWorkspace.allocationCount();
+        EXPECT_TRUE(outOfCoreCYK.predict(word, outOfCoreWorkspace));
+        EXPECT_TRUE(outOfCoreCYK.predict("()", outOfCoreWorkspace));
+        EXPECT_EQ(outOfCoreWorkspace.allocationCount(), allocationCount);
+    }
+    EXPECT_EQ(capacities[0], capacities[2]);
+    EXPECT_EQ(capacities[1], capacities[2]);
+
+    CYKOptions options;
+    options.maxInMemoryChartSize = 1;
+    options.scratchDirectory = "/nonexistent/directory";
+    CYK failingCYK(grammar, options);
+    EXPECT_THROW(failingCYK.predict(word), ScratchFileException);
+}
+
+TEST(CYK, PredictionLimits) {
+    ContextFreeGrammar grammar({'(', ')'}, {'S'}, 'S', {{"S", "SS"}, {"S", ""}, {"S", "(S)"}});
+    std::string word = "(())()()(((())()()))()((())()())()((()()))()()(()(()))";
+
+    for (auto layout: {ChartLayout::Square, ChartLayout::TriangularTiled}) {
+        CYKOptions options;
+        options.layout = layout;
+        options.tileSize = 8;
+        CYK cyk(grammar, options);
+
+        std::vector<double> progress;
+        PredictionLimits limits;
+        limits.progressHandler = [&](double fraction) {
+            progress.push_back(fraction);
+        };
+        EXPECT_EQ(cyk.predict(word, limits), PredictionResult::Accepted);
+        ASSERT_FALSE(progress.empty());
+        EXPECT_TRUE(std::is_sorted(progress.begin(), progress.end()));
+        EXPECT_DOUBLE_EQ(progress.back(), 1);
+        EXPECT_EQ(cyk.predict(word + "(", limits), PredictionResult::Rejected);
+        EXPECT_EQ(cyk.predict("", limits), PredictionResult::Accepted);
+
+        limits = {};
+        limits.deadline = std::chrono::steady_clock::now();
+        EXPECT_EQ(cyk.predict(word, limits), PredictionResult::Interrupted);
+
+        CancellationToken cancellationToken;
+        limits = {};
+        limits.cancellationToken = &cancellationToken;
+        limits.progressHandler = [&](double fraction) {
+            if (fraction > 0.5) {
+                cancellationToken.cancel();
+            }
+        };
+        EXPECT_FALSE(cancellationToken.isCancelled());
+        EXPECT_EQ(cyk.predict(word, limits), PredictionResult::Interrupted);
+        EXPECT_TRUE(cancellationToken.isCancelled());
+        EXPECT_EQ(cyk.predict("()", limits), PredictionResult::Interrupted);
+    }
+}
+
+TEST(CYK, ChartQueries) {
+    ContextFreeGrammar grammar(
+        {'(', ')', 'a'},
+        {'S', 'A'},
+        'S',
+        {{"S", "SS"}, {"S", "(S)"}, {"S", "()"}, {"S", "A"}, {"A", "a"}, {"A", "aA"}}
+    );
+    std::string word = "(a)(()a)a((a)";
+    for (auto layout: {ChartLayout::Square, ChartLayout::TriangularTiled}) {
+        CYKOptions options;
+        options.layout = layout;
+        CYK cyk(grammar, options);
+        auto chart = cyk.chart(word);
+        EXPECT_EQ(chart.wordSize(), word.size());
+        EXPECT_FALSE(chart.accepted());
+
+        std::vector<std::pair<size_t, size_t>> spans;
+        for (size_t i = 0; i < word.size(); ++i) {
+            for (size_t j = i; j < word.size(); ++j) {
+                EXPECT_EQ(chart.accepts(i, j), cyk.predict(word.substr(i, j - i + 1)));
+                EXPECT_EQ(chart.derives('A', i, j), i == j && word[i] == 'a');
+                if (chart.accepts(i, j)) {
+                    spans.emplace_back(i, j - i + 1);
+                }
+            }
+        }
+        auto acceptedSpans = chart.acceptedSpans();
+        ASSERT_EQ(acceptedSpans.size(), spans.size());
+        for (size_t i = 0; i < spans.size(); ++i) {
+            EXPECT_EQ(acceptedSpans[i].start, spans[i].first);
+            EXPECT_EQ(acceptedSpans[i].size, spans[i].second);
+        }
+        EXPECT_FALSE(chart.derives('B', 0, 0));
+        EXPECT_TRUE(chart.spansAcceptedBy('B').empty());
+    }
+
+    CYK cyk(grammar);
+    EXPECT_TRUE(cyk.chart("(a)a").accepted());
+    EXPECT_FALSE(cyk.chart("").accepted());
+    EXPECT_TRUE(cyk.chart("").acceptedSpans().empty());
+}
+
+TEST(CYK, ChartBounds) {
+    ContextFreeGrammar grammar({'a', 'b'}, {'S'}, 'S', {{"S", "aSb"}, {"S", "ab"}});
+    auto chart = CYK(grammar).chart("aabb");
+    EXPECT_TRUE(chart.accepted());
+    EXPECT_TRUE(chart.accepts(1, 2));
+    EXPECT_EQ(chart.acceptedSpans().size(), 2);
+
+    EXPECT_FALSE(chart.derives('S', 3, 40));
+    EXPECT_FALSE(chart.derives('S', 2, 1));
+    EXPECT_FALSE(chart.derives('S', 4, 4));
+    EXPECT_FALSE(chart.accepts(0, 4));
+    EXPECT_FALSE(chart.accepts(3, 0));
+    EXPECT_FALSE(CYK(grammar).chart("").derives('S', 0, 0));
+}
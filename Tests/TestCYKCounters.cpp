@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include <FL/CYK.hpp>
+#include <FL/CYKCounters.hpp>
+#include <string>
+#include <thread>
+
+using namespace FL;
+
+namespace {
+
+ContextFreeGrammar const brackets(
+    {'(', ')'},
+    {'S'},
+    'S',
+    {{"S", "SS"}, {"S", "(S)"}, {"S", ""}}
+);
+
+}
+
+TEST(CYKCounters, Merge) {
+    CYKCounters counters;
+    counters.computedCellCount = 3;
+    counters.peakChartBytes = 100;
+    CYKCounters otherCounters;
+    otherCounters.computedCellCount = 4;
+    otherCounters.peakChartBytes = 50;
+    counters.merge(otherCounters);
+    EXPECT_EQ(counters.computedCellCount, 7);
+    EXPECT_EQ(counters.peakChartBytes, 100);
+
+    EXPECT_NE(counters.toText().find("computedCellCount: 7\n"), std::string::npos);
+    EXPECT_NE(counters.toJSON().find("\"peakChartBytes\": 100}"), std::string::npos);
+    EXPECT_EQ(counters.toJSON().front(), '{');
+
+    counters.clear();
+    EXPECT_EQ(counters.computedCellCount, 0);
+}
+
+TEST(CYKCounters, Predict) {
+    CYK cyk(brackets);
+    CYK::Workspace workspace;
+    CYKCounters::reset();
+    EXPECT_TRUE(cyk.predict("(()())", workspace));
+    std::thread([&cyk] {
+        EXPECT_FALSE(cyk.predict("(()"));
+    }).join();
+
+    auto counters = workspace.counters();
+    auto total = CYKCounters::snapshot();
+    if (!instrumentationEnabled) {
+        EXPECT_EQ(counters.computedCellCount, 0);
+        EXPECT_EQ(total.chartCount, 0);
+        return;
+    }
+
+    EXPECT_EQ(counters.chartCount, 1);
+    EXPECT_EQ(counters.computedCellCount, 15);
+    EXPECT_GT(counters.ruleCheckCount, 0);
+    EXPECT_GT(counters.derivedSymbolCount, 0);
+    EXPECT_GE(counters.peakChartBytes, 36 * sizeof(std::uint64_t));
+    EXPECT_GT(counters.allocatedBytes, 0);
+
+    EXPECT_EQ(total.chartCount, 2);
+    EXPECT_EQ(total.computedCellCount, 18);
+    EXPECT_EQ(total.peakChartBytes, counters.peakChartBytes);
+
+    EXPECT_TRUE(cyk.predict("()", workspace));
+    EXPECT_EQ(workspace.counters().allocatedBytes, 0);
+    CYKCounters::reset();
+    EXPECT_EQ(CYKCounters::snapshot().chartCount, 0);
+}
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+
+#include <FL/CodeGenerator.hpp>
+#include <FL/CYK.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace FL;
+
+namespace {
+
+ContextFreeGrammar const brackets(
+    {'(', ')'},
+    {'S'},
+    'S',
+    {{"S", "SS"}, {"S", "()"}, {"S", "(S)"}, {"S", ""}}
+);
+
+char const* const driverSource = R"(
+#include <iostream>
+#include <string>
+
+int main() {
+    std::string word;
+    while (std::getline(std::cin, word)) {
+        std::cout << Generated::Recognizer::recognize(word);
+    }
+}
+)";
+
+ContextFreeGrammar wideGrammar(size_t nonterminalCount) {
+    Alphabet nonterminals;
+    std::vector<Grammar::Rule> rules;
+    for (size_t i = 0; i < nonterminalCount; ++i) {
+        Symbol nonterminal(static_cast<int>(1000 + i));
+        nonterminals.insert(nonterminal);
+        rules.push_back({
+            Word{nonterminal},
+            Word{
+                Symbol(static_cast<int>(1000 + (i + 1) % nonterminalCount)),
+                Symbol(static_cast<int>(1000 + (i + 7) % nonterminalCount))
+            }
+        });
+        rules.push_back({Word{nonterminal}, Word{Symbol(static_cast<char>('a' + i % 3))}});
+    }
+    return ContextFreeGrammar({'a', 'b', 'c'}, nonterminals, Symbol(1000), rules);
+}
+
+void expectAgreesWithCYK(
+    ContextFreeGrammar const& grammar,
+    std::string const& alphabet,
+    size_t maxWordSize
+) {
+    auto directory = testing::TempDir();
+    auto sourcePath = directory + "flp-generated.cpp";
+    auto binaryPath = directory + "flp-generated";
+    auto inputPath = directory + "flp-generated.in";
+    auto outputPath = directory + "flp-generated.out";
+    {
+        std::ofstream source(sourcePath);
+        CodeGenerator(grammar, {"Generated::Recognizer"}).write(source);
+        source << driverSource;
+    }
+
+    std::vector<std::string> words{""};
+    for (size_t i = 0; i < words.size() && words[i].size() < maxWordSize; ++i) {
+        for (char symbol: alphabet) {
+            words.push_back(words[i] + symbol);
+        }
+    }
+    {
+        std::ofstream input(inputPath);
+        for (auto const& word: words) {
+            input << word << '\n';
+        }
+    }
+
+    auto command = "c++ -std=c++17 -O2 " + sourcePath + " -o " + binaryPath;
+    ASSERT_EQ(std::system(command.c_str()), 0);
+    command = binaryPath + " < " + inputPath + " > " + outputPath;
+    ASSERT_EQ(std::system(command.c_str()), 0);
+
+    std::string results;
+    std::getline(std::ifstream(outputPath), results);
+    ASSERT_EQ(results.size(), words.size());
+    CYK cyk(grammar);
+    for (size_t i = 0; i < words.size(); ++i) {
+        EXPECT_EQ(results[i] == '1', cyk.predict(words[i])) << words[i];
+    }
+
+    for (auto const& path: {sourcePath, binaryPath, inputPath, outputPath}) {
+        std::remove(path.c_str());
+    }
+}
+
+}
+
+TEST(CodeGenerator, Generate) {
+    CodeGenerator generator(brackets, {"Generated::Brackets"});
+    auto source = generator.generate();
+    EXPECT_NE(source.find("namespace Generated::Brackets {"), std::string::npos);
+    EXPECT_NE(source.find("using Word = std::uint"), std::string::npos);
+    EXPECT_NE(source.find("case 40:"), std::string::npos);
+    EXPECT_NE(source.find("constexpr bool acceptsEmptyWord = true;"), std::string::npos);
+    EXPECT_EQ(source.find("case 97:"), std::string::npos);
+    EXPECT_GT(generator.binaryRuleCount(), 0);
+
+    CodeGenerator wideGenerator(wideGrammar(70));
+    EXPECT_GT(wideGenerator.nonterminalCount(), 64);
+    auto wideSource = wideGenerator.generate();
+    EXPECT_NE(wideSource.find("constexpr std::size_t wordCount = 2;"), std::string::npos);
+
+    EXPECT_THROW(CodeGenerator(brackets, {"1Brackets"}), InvalidNamespaceException);
+    EXPECT_THROW(CodeGenerator(brackets, {"Generated::"}), InvalidNamespaceException);
+    EXPECT_THROW(
+        CodeGenerator(ContextFreeGrammar({1000}, {'S'}, 'S', {{Word{'S'}, Word{1000}}})),
+        NonByteTerminalException
+    );
+}
+
+TEST(CodeGenerator, CompiledRecognizerAgreesWithCYK) {
+    if (std::system("c++ --version > /dev/null 2>&1") != 0) {
+        GTEST_SKIP() << "No C++ compiler available";
+    }
+
+    expectAgreesWithCYK(brackets, "()a", 8);
+    expectAgreesWithCYK(wideGrammar(70), "abc", 6);
+}
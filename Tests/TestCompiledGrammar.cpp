@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#include <FL/ContextFreeGrammar.hpp>
+#include <FL/CompiledGrammar.hpp>
+#include <FL/CYK.hpp>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace FL;
+
+namespace {
+
+void saveBinaryRule(std::string const& path, std::uint64_t rightChild, std::uint64_t parent) {
+    ContextFreeGrammar grammar({'a'}, {'S'}, 'S', {{"S", "SS"}, {"S", "a"}});
+    CompiledGrammarWriter writer;
+    writer.write(grammar);
+    writer.write(grammar);
+    writer.write(Word{'S'});
+    for (std::uint64_t value: {1, 0, 0, 1}) {
+        writer.write(value);
+    }
+    writer.write(Symbol('a'));
+    for (auto value: std::vector<std::uint64_t>{1, 2, 0, 1, 1, rightChild, parent}) {
+        writer.write(value);
+    }
+    writer.save(path, grammarHash(grammar));
+}
+
+}
+
+TEST(CompiledGrammar, SaveAndLoad) {
+    ContextFreeGrammar grammar(
+        {'(', ')', 'a'},
+        {'S', 'A'},
+        'S',
+        {{"S", "SS"}, {"S", "(S)"}, {"S", ""}, {"S", "A"}, {"A", "a", 0.5}, {"A", "aA", 0.5}}
+    );
+    std::string path = testing::TempDir() + "flp-grammar.bin";
+    CYK cyk(grammar);
+    cyk.save(path);
+
+    auto loadedCYK = CYK::load(path);
+    EXPECT_EQ(loadedCYK.grammar().rules(), cyk.grammar().rules());
+    EXPECT_EQ(loadedCYK.sourceGrammar().rules(), grammar.rules());
+    EXPECT_EQ(loadedCYK.grammar().startSymbol(), cyk.grammar().startSymbol());
+    for (std::string word: {"", "a", "(aa)()", "((a)", "(()())aa(a)", "b", ")("}) {
+        EXPECT_EQ(loadedCYK.predict(word), cyk.predict(word));
+    }
+    auto forest = loadedCYK.parse("(a)a");
+    EXPECT_EQ(forest.treeCount(), cyk.parse("(a)a").treeCount());
+    EXPECT_EQ(forest.tree().nodes.size(), cyk.parse("(a)a").tree().nodes.size());
+
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(sizeof(CompiledGrammarHeader) + 8);
+    file.put('\x7f');
+    file.close();
+    EXPECT_THROW(CYK::load(path), CompiledGrammarException);
+    EXPECT_THROW(CYK::load(path + ".missing"), CompiledGrammarException);
+
+    cyk.save(path);
+    CompiledGrammarHeader header;
+    file.open(path, std::ios::in | std::ios::out | std::ios::binary);
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    header.payloadSize += std::uint64_t(1) << 61;
+    file.seekp(0);
+    file.write(reinterpret_cast<char const*>(&header), sizeof(header));
+    file.close();
+    EXPECT_THROW(CYK::load(path), CompiledGrammarException);
+    std::remove(path.c_str());
+}
+
+TEST(CompiledGrammar, StaleCache) {
+    ContextFreeGrammar grammar({'a', 'b'}, {'S'}, 'S', {{"S", "aSb"}, {"S", "ab"}});
+    std::string path = testing::TempDir() + "flp-cache.bin";
+    std::remove(path.c_str());
+
+    auto cyk = CYK::loadOrCompile(grammar, path);
+    EXPECT_TRUE(cyk.predict("aabb"));
+    EXPECT_EQ(CompiledGrammarReader(path).header().sourceHash, grammarHash(grammar));
+    EXPECT_TRUE(CYK::loadOrCompile(grammar, path).predict("ab"));
+
+    ContextFreeGrammar changedGrammar({'a', 'b'}, {'S'}, 'S', {{"S", "aSb"}, {"S", ""}});
+    EXPECT_NE(grammarHash(changedGrammar), grammarHash(grammar));
+    cyk = CYK::loadOrCompile(changedGrammar, path);
+    EXPECT_TRUE(cyk.predict(""));
+    EXPECT_EQ(CompiledGrammarReader(path).header().sourceHash, grammarHash(changedGrammar));
+    std::remove(path.c_str());
+}
+
+TEST(CompiledGrammar, RuleIndicesInRange) {
+    std::string path = testing::TempDir() + "flp-rules.bin";
+    saveBinaryRule(path, 0, 0);
+    EXPECT_TRUE(CYK::load(path).predict("aaa"));
+    saveBinaryRule(path, 5, 0);
+    EXPECT_THROW(CYK::load(path), CompiledGrammarException);
+    saveBinaryRule(path, 0, 1);
+    EXPECT_THROW(CYK::load(path), CompiledGrammarException);
+    std::remove(path.c_str());
+}
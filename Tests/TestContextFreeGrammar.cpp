@@ -2,6 +2,7 @@
 
 #include <FL/ContextFreeGrammar.hpp>
 #include <algorithm>
+#include <unordered_set>
 #include <vector>
 #include <tuple>
 
@@ -11,8 +12,10 @@ struct ContextFreeGrammarPrivate: public ContextFreeGrammar {
     using ContextFreeGrammar::ContextFreeGrammar;
     using ContextFreeGrammar::removeLongRules;
     using ContextFreeGrammar::findEpsilonGenerators;
+    using ContextFreeGrammar::findEpsilonProbabilities;
     using ContextFreeGrammar::removeEmptyRules;
     using ContextFreeGrammar::findChainedPairs;
+    using ContextFreeGrammar::findChainProbabilities;
     using ContextFreeGrammar::removeChainRules;
     using ContextFreeGrammar::findGeneratingNonterminals;
     using ContextFreeGrammar::removeNonGeneratingRules;
@@ -261,6 +264,112 @@ TEST(ContextFreeGrammar, Normalization) {
     EXPECT_TRUE(normalized.normalized().isNormalized());
 }
 
+TEST(ContextFreeGrammar, NormalizationReport) {
+    ContextFreeGrammar grammar(
+        {'(', ')'},
+        {'S'},
+        'S',
+        {{"S", "SS"}, {"S", ""}, {"S", "(S)"}}
+    );
+    NormalizationReport report;
+    auto normalized = grammar.normalized(&report);
+    ASSERT_EQ(report.phases.size(), 6);
+    EXPECT_EQ(report.phases[0].name, "long rules");
+    EXPECT_EQ(report.phases[0].ruleCountBefore, 3);
+    EXPECT_EQ(report.phases[0].freshNonterminalCount, 1);
+    EXPECT_EQ(report.phases[0].nonterminalCountAfter, 2);
+    EXPECT_EQ(report.phases[5].name, "mixed rules");
+    EXPECT_EQ(report.phases[5].ruleCountAfter, normalized.rules().size());
+    EXPECT_EQ(report.phases[5].nonterminalCountAfter, normalized.nonterminals().size());
+
+    size_t freshNonterminalCount = 0;
+    for (size_t i = 0; i < report.phases.size(); ++i) {
+        freshNonterminalCount += report.phases[i].freshNonterminalCount;
+        EXPECT_GE(report.phases[i].seconds, 0);
+        if (i > 0) {
+            EXPECT_EQ(report.phases[i].ruleCountBefore, report.phases[i - 1].ruleCountAfter);
+        }
+    }
+    EXPECT_GE(freshNonterminalCount, normalized.auxiliaryNonterminals().size());
+
+    EXPECT_EQ(report.nonterminalCount, normalized.nonterminals().size());
+    EXPECT_EQ(report.cellWordCount, 1);
+    EXPECT_GT(report.binaryRuleCount, 0);
+    EXPECT_GT(report.terminalRuleCount, 0);
+    EXPECT_DOUBLE_EQ(report.predictedSplitCost(), report.binaryRuleCount + 1);
+    EXPECT_DOUBLE_EQ(report.predictedCellCost(1), 0);
+    EXPECT_DOUBLE_EQ(report.predictedCellCost(4), 3 * report.predictedSplitCost());
+    EXPECT_NE(report.toText().find("chain rules: "), std::string::npos);
+
+    normalized.normalize(&report);
+    EXPECT_TRUE(report.phases.empty());
+    EXPECT_EQ(report.nonterminalCount, normalized.nonterminals().size());
+}
+
+TEST(ContextFreeGrammar, NormalizationReportRemovedNonterminals) {
+    ContextFreeGrammar grammar(
+        {'a', 'b'},
+        {'S', 'A', 'B', 'C', 'D'},
+        'S',
+        {{"S", "aSb"}, {"S", "ab"}, {"S", "aA"}, {"A", "Ab"}, {"B", "BC"}, {"C", "a"}, {"D", "b"}}
+    );
+    NormalizationReport report;
+    auto normalized = grammar.normalized(&report);
+    ASSERT_EQ(report.phases.size(), 6);
+    auto const& nonGenerating = report.phases[3];
+    EXPECT_EQ(nonGenerating.name, "non-generating");
+    EXPECT_EQ(nonGenerating.nonterminalCountAfter, nonGenerating.nonterminalCountBefore - 2);
+    auto const& nonReachable = report.phases[4];
+    EXPECT_EQ(nonReachable.name, "non-reachable");
+    EXPECT_EQ(nonReachable.nonterminalCountAfter, nonReachable.nonterminalCountBefore - 2);
+
+    std::unordered_set<Symbol> liveNonterminals{normalized.startSymbol()};
+    for (auto const& [lhs, rhs]: normalized.rules()) {
+        liveNonterminals.insert(lhs[0]);
+        for (auto symbol: rhs) {
+            if (normalized.symbolIsNonterminal(symbol)) {
+                liveNonterminals.insert(symbol);
+            }
+        }
+    }
+    EXPECT_EQ(normalized.nonterminals().size(), liveNonterminals.size());
+    EXPECT_EQ(report.nonterminalCount, liveNonterminals.size());
+}
+
+TEST(ContextFreeGrammar, RuleProbabilities) {
+    ContextFreeGrammarPrivate grammar(
+        {'a', 'b'},
+        {'S', 'A', 'B'},
+        'S',
+        {{"S", "AB", 0.5}, {"S", "A", 0.5}, {"A", "", 0.3}, {"A", "B", 0.7}, {"B", "", 0.2}}
+    );
+    auto epsilonProbabilities = grammar.findEpsilonProbabilities();
+    EXPECT_EQ(epsilonProbabilities.size(), 3);
+    EXPECT_DOUBLE_EQ(epsilonProbabilities['B'], 0.2);
+    EXPECT_DOUBLE_EQ(epsilonProbabilities['A'], 0.3);
+    EXPECT_DOUBLE_EQ(epsilonProbabilities['S'], 0.15);
+
+    auto chainProbabilities = grammar.findChainProbabilities();
+    EXPECT_DOUBLE_EQ(chainProbabilities['S']['A'], 0.5);
+    EXPECT_DOUBLE_EQ(chainProbabilities['S']['B'], 0.35);
+    EXPECT_DOUBLE_EQ(chainProbabilities['A']['B'], 0.7);
+    EXPECT_FALSE(chainProbabilities['B'].count('A'));
+
+    grammar = ContextFreeGrammar({'a', 'b'}, {'S'}, 'S', {{"S", "aSb", 0.6}, {"S", "", 0.4}});
+    grammar.normalize();
+    EXPECT_TRUE(grammar.isNormalized());
+    for (auto const& rule: grammar.rules()) {
+        if (rule.rhs.empty()) {
+            EXPECT_DOUBLE_EQ(rule.probability, 0.4);
+        }
+        EXPECT_GT(rule.probability, 0);
+        EXPECT_LE(rule.probability, 1);
+    }
+
+    EXPECT_NE(Grammar::Rule("S", "a", 0.5), Grammar::Rule("S", "a", 0.25));
+    EXPECT_EQ(Grammar::Rule("S", "a"), Grammar::Rule("S", "a", 1));
+}
+
 TEST(ContextFreeGrammar, ExceptionMessages) {
     try {
         ContextFreeGrammar grammar(Grammar({'a'}, {'A'}, 'A', {{"A", "AA"}, {"aA", "a"}}));
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <FL/GrammarLoader.hpp>
+#include <FL/CYK.hpp>
+#include <string>
+
+using namespace FL;
+
+TEST(GrammarLoader, Load) {
+    GrammarLoader loader(
+        "# Arithmetic expressions\n"
+        "expr ::= term ('+' term)* ;\n"
+        "term ::= factor { \"*\" factor }\n"
+        "factor ::= <number> | '(' expr ')'\n"
+        "<number> ::= digit+\n"
+        "digit ::= '0' | '1' | '2' ;\n"
+    );
+    EXPECT_EQ(loader.startSymbol(), loader.nonterminal("expr"));
+    EXPECT_EQ(loader.nonterminalName(loader.nonterminal("number")), "number");
+    EXPECT_TRUE(loader.hasNonterminal("digit"));
+    EXPECT_FALSE(loader.hasNonterminal("expression"));
+    EXPECT_THROW(loader.nonterminal("expression"), UnknownNonterminalException);
+    EXPECT_EQ(loader.helperCount(), 3);
+    EXPECT_EQ(loader.nonterminals().size(), 8);
+    EXPECT_EQ(loader.terminals(), Alphabet({'+', '*', '(', ')', '0', '1', '2'}));
+
+    CYK cyk(loader.grammar());
+    for (std::string word: {"1", "10+2", "1+2*(10+2)", "((0))*22"}) {
+        EXPECT_TRUE(cyk.predict(word));
+    }
+    for (std::string word: {"", "1+", "(1", "1**2", "3"}) {
+        EXPECT_FALSE(cyk.predict(word));
+    }
+}
+
+TEST(GrammarLoader, SharedHelpers) {
+    GrammarLoader loader(
+        "a ::= 'x' ('+' b)* | 'z'? 'v'\n"
+        "b ::= 'y' ('+' b)* | ['z'] 'w' | 'ab' ('c')\n"
+    );
+    EXPECT_EQ(loader.helperCount(), 2);
+    EXPECT_EQ(loader.rules().size(), 9);
+
+    CYK cyk(loader.grammar());
+    for (std::string word: {"x", "x+y+zw", "v", "zv", "x+abc+w"}) {
+        EXPECT_TRUE(cyk.predict(word));
+    }
+    for (std::string word: {"zzv", "x+", "ab", "y"}) {
+        EXPECT_FALSE(cyk.predict(word));
+    }
+}
+
+TEST(GrammarLoader, LargeGrammar) {
+    size_t const ruleCount = 100000;
+    std::string text;
+    for (size_t i = 0; i < ruleCount; ++i) {
+        text += "n" + std::to_string(i) + " ::= 'a' n" + std::to_string(i + 1) + " | 'b'\n";
+    }
+    text += "n" + std::to_string(ruleCount) + " ::= ''\n";
+
+    GrammarLoader loader(text);
+    EXPECT_EQ(loader.rules().size(), 2 * ruleCount + 1);
+    EXPECT_EQ(loader.nonterminals().size(), ruleCount + 1);
+    EXPECT_EQ(loader.rules().back().rhs, emptyWord);
+    EXPECT_EQ(loader.nonterminalName(loader.rules()[2 * ruleCount - 2].lhs[0]), "n99999");
+}
+
+TEST(GrammarLoader, Errors) {
+    auto errorLine = [](std::string const& text) -> size_t {
+        try {
+            GrammarLoader loader(text);
+        } catch (GrammarFormatException const& exception) {
+            return exception.line;
+        }
+        return 0;
+    };
+    EXPECT_EQ(errorLine(""), 1);
+    EXPECT_EQ(errorLine("a ::= 'x\n"), 1);
+    EXPECT_EQ(errorLine("a ::= 'x'\n\nb 'y'"), 3);
+    EXPECT_EQ(errorLine("a ::= ('x'\nb ::= 'y'"), 2);
+    EXPECT_EQ(errorLine("a ::= 'x'\n  | b\n"), 2);
+    EXPECT_EQ(errorLine("a ::= 'x' $"), 1);
+    EXPECT_EQ(errorLine("a ::= <b\n"), 1);
+    EXPECT_THROW(GrammarLoader::load("missing.bnf"), GrammarFormatException);
+}
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+
+#include <FL/ContextFreeGrammar.hpp>
+#include <FL/CYK.hpp>
+#include <FL/LRTable.hpp>
+#include <string>
+#include <vector>
+
+using namespace FL;
+
+namespace {
+
+std::vector<std::string> enumerateWords(std::string const& alphabet, size_t maxSize) {
+    std::vector<std::string> words{""};
+    for (size_t i = 0; i < words.size() && words[i].size() < maxSize; ++i) {
+        for (char symbol: alphabet) {
+            words.push_back(words[i] + symbol);
+        }
+    }
+    return words;
+}
+
+}
+
+TEST(LRTable, DeterministicGrammars) {
+    std::vector<std::pair<ContextFreeGrammar, std::string>> grammars{
+        {
+            ContextFreeGrammar(
+                {'a', '+', '*', '(', ')'},
+                {'E', 'T', 'F'},
+                'E',
+                {{"E", "E+T"}, {"E", "T"}, {"T", "T*F"}, {"T", "F"}, {"F", "(E)"}, {"F", "a"}}
+            ),
+            "a+*()"
+        },
+        {
+            ContextFreeGrammar(
+                {'a', '*', '='},
+                {'S', 'L', 'R'},
+                'S',
+                {{"S", "L=R"}, {"S", "R"}, {"L", "*R"}, {"L", "a"}, {"R", "L"}}
+            ),
+            "a*="
+        },
+        {
+            ContextFreeGrammar({'(', ')'}, {'S'}, 'S', {{"S", "(S)S"}, {"S", ""}}),
+            "()"
+        }
+    };
+    for (auto const& [grammar, alphabet]: grammars) {
+        LRRecognizer recognizer(grammar);
+        ASSERT_TRUE(recognizer.isDeterministic());
+        EXPECT_LT(recognizer.table().compressedSize(), recognizer.table().denseSize());
+
+        CYK cyk(grammar);
+        std::vector<std::uint32_t> stack;
+        for (auto const& word: enumerateWords(alphabet, 6)) {
+            EXPECT_EQ(recognizer.table().predict(word, stack), cyk.predict(word)) << word;
+        }
+    }
+    EXPECT_FALSE(LRRecognizer(grammars[0].first).predict("a+b"));
+}
+
+TEST(LRTable, Conflicts) {
+    ContextFreeGrammar brackets(
+        {'(', ')'},
+        {'S'},
+        'S',
+        {{"S", "SS"}, {"S", "()"}, {"S", "(S)"}, {"S", ""}}
+    );
+    LRRecognizer recognizer(brackets);
+    EXPECT_FALSE(recognizer.isDeterministic());
+    EXPECT_FALSE(recognizer.conflicts().empty());
+    CYK cyk(brackets);
+    for (auto const& word: enumerateWords("()", 8)) {
+        EXPECT_EQ(recognizer.predict(word), cyk.predict(word)) << word;
+    }
+
+    LRTable table(ContextFreeGrammar(
+        {'a', 'b', 'c', 'd', 'e'},
+        {'S', 'A', 'B'},
+        'S',
+        {{"S", "aAd"}, {"S", "bBd"}, {"S", "aBe"}, {"S", "bAe"}, {"A", "c"}, {"B", "c"}}
+    ));
+    ASSERT_FALSE(table.isDeterministic());
+    for (auto const& conflict: table.conflicts()) {
+        EXPECT_EQ(conflict.type, LRConflictType::ReduceReduce);
+        EXPECT_FALSE(conflict.isAtEndOfInput);
+        EXPECT_TRUE(conflict.lookahead == 'd' || conflict.lookahead == 'e');
+        EXPECT_EQ(conflict.rule, 5);
+    }
+}
@@ -0,0 +1,34 @@
+#include <gtest/gtest.h>
+
+#include <FL/LatencyHistogram.hpp>
+
+using namespace FL;
+
+TEST(LatencyHistogram, Percentiles) {
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.percentile(0.5), 0);
+    for (std::uint64_t value = 1; value <= 1000; ++value) {
+        histogram.record(value);
+    }
+    EXPECT_EQ(histogram.count(), 1000);
+    EXPECT_EQ(histogram.max(), 1000);
+    EXPECT_DOUBLE_EQ(histogram.mean(), 500.5);
+    EXPECT_EQ(histogram.percentile(0.01), 10);
+    EXPECT_EQ(histogram.percentile(1), 1000);
+    for (double fraction: {0.5, 0.9, 0.99}) {
+        double expected = fraction * 1000;
+        EXPECT_GE(histogram.percentile(fraction), expected);
+        EXPECT_LE(histogram.percentile(fraction), expected * 1.07);
+    }
+
+    LatencyHistogram other;
+    other.record(std::uint64_t(1) << 40);
+    histogram.merge(other);
+    EXPECT_EQ(histogram.count(), 1001);
+    EXPECT_EQ(histogram.percentile(1), std::uint64_t(1) << 40);
+    EXPECT_LE(histogram.percentile(0.5), 501 * 1.07);
+
+    histogram.clear();
+    EXPECT_EQ(histogram.count(), 0);
+    EXPECT_EQ(histogram.max(), 0);
+}
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+
+#include <FL/ContextFreeGrammar.hpp>
+#include <FL/CYK.hpp>
+#include <FL/Lexer.hpp>
+#include <string>
+#include <vector>
+
+using namespace FL;
+
+namespace {
+
+enum Token {
+    Number = 256,
+    Identifier,
+    Keyword,
+    Plus,
+    Times,
+    LeftParenthesis,
+    RightParenthesis
+};
+
+std::vector<TokenDefinition> const tokenDefinitions{
+    {"let|in", Keyword},
+    {"[0-9]+(\\.\\d+)?", Number},
+    {"[a-zA-Z_]\\w*", Identifier},
+    {"\\+", Plus},
+    {"\\*", Times},
+    {"\\(", LeftParenthesis},
+    {"\\)", RightParenthesis},
+    {"\\s+|#[^\\n]*", 0, true},
+    {"\\.", '.'}
+};
+
+}
+
+TEST(Lexer, Tokenize) {
+    Lexer lexer(tokenDefinitions);
+    EXPECT_GT(lexer.stateCount(), 1);
+    EXPECT_EQ(
+        lexer.tokenize("let letter in\n(x1 + 3.25) * _y # comment\n*4"),
+        Word({
+            Keyword, Identifier, Keyword,
+            LeftParenthesis, Identifier, Plus, Number, RightParenthesis, Times, Identifier,
+            Times, Number
+        })
+    );
+    EXPECT_EQ(lexer.tokenize("3.x"), Word({Number, Symbol('.'), Identifier}));
+
+    Word word{Plus};
+    lexer.tokenize("", word);
+    EXPECT_TRUE(word.empty());
+    EXPECT_THROW(lexer.tokenize("x = 1"), UnexpectedCharacterException);
+
+    EXPECT_THROW(Lexer({{"a|b*", 1}}), InvalidTokenPatternException);
+    EXPECT_THROW(Lexer({{"(ab", 1}}), InvalidTokenPatternException);
+    EXPECT_THROW(Lexer({{"ab)", 1}}), InvalidTokenPatternException);
+    EXPECT_THROW(Lexer({{"[ab", 1}}), InvalidTokenPatternException);
+    EXPECT_THROW(Lexer({{"*", 1}}), InvalidTokenPatternException);
+}
+
+TEST(Lexer, TokenizedPrediction) {
+    ContextFreeGrammar grammar(
+        {Number, Identifier, Plus, Times, LeftParenthesis, RightParenthesis},
+        {'E', 'T', 'F'},
+        'E',
+        {
+            {Word{'E'}, Word{'E', Plus, 'T'}},
+            {Word{'E'}, Word{'T'}},
+            {Word{'T'}, Word{'T', Times, 'F'}},
+            {Word{'T'}, Word{'F'}},
+            {Word{'F'}, Word{LeftParenthesis, 'E', RightParenthesis}},
+            {Word{'F'}, Word{Number}},
+            {Word{'F'}, Word{Identifier}}
+        }
+    );
+    CYK cyk(grammar);
+    Lexer lexer(tokenDefinitions);
+
+    auto word = lexer.tokenize("(x + 2) * (y + 3.5 * z)");
+    EXPECT_EQ(word.size(), 13);
+    EXPECT_TRUE(cyk.predict(word));
+    EXPECT_TRUE(cyk.predict({word.data() + 1, 3}));
+    EXPECT_FALSE(cyk.predict({word.data(), 3}));
+    EXPECT_FALSE(cyk.predict(lexer.tokenize("(x + 2 * y")));
+    EXPECT_FALSE(cyk.predict(Word{}));
+    EXPECT_FALSE(cyk.predict("x+2"));
+}
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+
+#include <FL/ContextFreeGrammar.hpp>
+#include <FL/MultiCYK.hpp>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using namespace FL;
+
+TEST(MultiCYK, AcceptingGrammars) {
+    ContextFreeGrammar brackets(
+        {'(', ')'},
+        {'S'},
+        'S',
+        {{"S", "SS"}, {"S", "()"}, {"S", "(S)"}, {"S", ""}}
+    );
+    std::vector<ContextFreeGrammar> grammars{
+        brackets,
+        ContextFreeGrammar({'a', 'b'}, {'S'}, 'S', {{"S", "aSb"}, {"S", "ab"}}),
+        brackets,
+        ContextFreeGrammar(
+            {'a', 'b'},
+            {'S', 'A'},
+            'S',
+            {{"S", "aSa"}, {"S", "bSb"}, {"S", "A"}, {"A", "a"}, {"A", "b"}, {"A", ""}}
+        ),
+        ContextFreeGrammar({'(', ')', 'a'}, {'S', 'A'}, 'S', {{"S", "(A)"}, {"A", "aA"}, {"A", ""}})
+    };
+    MultiCYK multiCYK(grammars);
+    EXPECT_EQ(multiCYK.grammarCount(), grammars.size());
+    EXPECT_EQ(
+        MultiCYK({brackets, brackets}).grammar().nonterminals().size(),
+        MultiCYK({brackets}).grammar().nonterminals().size()
+    );
+
+    std::vector<CYK> cyks(grammars.begin(), grammars.end());
+    std::vector<std::string> words{""};
+    for (size_t i = 0; i < words.size() && words[i].size() < 5; ++i) {
+        for (char symbol: {'a', 'b', '(', ')'}) {
+            words.push_back(words[i] + symbol);
+        }
+    }
+    CYK::Workspace workspace;
+    for (auto const& word: words) {
+        std::vector<size_t> expectedGrammars;
+        for (size_t i = 0; i < cyks.size(); ++i) {
+            if (cyks[i].predict(word)) {
+                expectedGrammars.push_back(i);
+            }
+        }
+        EXPECT_EQ(multiCYK.acceptingGrammars(word, workspace), expectedGrammars) << word;
+    }
+
+    EXPECT_TRUE(MultiCYK({}).acceptingGrammars("a").empty());
+    EXPECT_FALSE((std::is_convertible_v<MultiCYK const&, CYK const&>));
+}
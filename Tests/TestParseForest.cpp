@@ -0,0 +1,200 @@
+#include <gtest/gtest.h>
+
+#include <FL/ContextFreeGrammar.hpp>
+#include <FL/CYK.hpp>
+#include <FL/ParseForest.hpp>
+#include <string>
+#include <set>
+
+using namespace FL;
+
+namespace {
+
+std::string format(ContextFreeGrammar const& grammar, ParseTree const& tree, size_t node) {
+    auto const& [symbol, rule, start, size, children] = tree.nodes[node];
+    std::string result(1, static_cast<char>(symbol.rawValue));
+    if (grammar.symbolIsTerminal(symbol)) {
+        return result;
+    }
+    result += "[" + std::to_string(start) + "," + std::to_string(start + size) + ")(";
+    for (size_t i = 0; i < children.size(); ++i) {
+        result += (i ? " " : "") + format(grammar, tree, children[i]);
+    }
+    return result + ")";
+}
+
+std::string format(ContextFreeGrammar const& grammar, ParseTree const& tree) {
+    return format(grammar, tree, tree.root);
+}
+
+bool isDerivation(
+    ContextFreeGrammar const& grammar,
+    ParseTree const& tree,
+    size_t node,
+    std::string& word
+) {
+    auto const& [symbol, rule, start, size, children] = tree.nodes[node];
+    if (grammar.symbolIsTerminal(symbol)) {
+        word += static_cast<char>(symbol.rawValue);
+        return children.empty();
+    }
+    if (rule >= grammar.rules().size()) {
+        return false;
+    }
+    auto const& [lhs, rhs] = grammar.rules()[rule];
+    if (lhs[0] != symbol || rhs.size() != children.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < children.size(); ++i) {
+        if (
+            tree.nodes[children[i]].symbol != rhs[i] ||
+            !isDerivation(grammar, tree, children[i], word)
+        ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<std::string> wordsUpTo(std::string const& alphabet, size_t maxSize) {
+    std::vector<std::string> words{""};
+    for (size_t i = 0; i < words.size(); ++i) {
+        if (words[i].size() < maxSize) {
+            for (auto character: alphabet) {
+                words.push_back(words[i] + character);
+            }
+        }
+    }
+    return words;
+}
+
+}
+
+TEST(ParseForest, SharedAmbiguousDerivations) {
+    ContextFreeGrammar grammar({'a'}, {'S'}, 'S', {{"S", "SS"}, {"S", "a"}});
+    CYK cyk(grammar);
+
+    std::vector<std::uint64_t> catalanNumbers{1, 1, 2, 5, 14, 42, 132, 429};
+    for (size_t n = 1; n <= catalanNumbers.size(); ++n) {
+        auto forest = cyk.parse(std::string(n, 'a'));
+        EXPECT_EQ(forest.treeCount(), catalanNumbers[n - 1]);
+        EXPECT_LE(forest.nodes().size(), n * (n + 1) / 2);
+    }
+
+    auto forest = cyk.parse("aaaa");
+    std::set<std::string> trees;
+    for (auto const& tree: forest) {
+        EXPECT_EQ(tree.nodes[tree.root].size, 4);
+        trees.insert(format(grammar, tree));
+    }
+    EXPECT_EQ(trees.size(), 5);
+    EXPECT_EQ(
+        format(grammar, forest.tree()),
+        "S[0,4)(S[0,1)(a) S[1,4)(S[1,2)(a) S[2,4)(S[2,3)(a) S[3,4)(a))))"
+    );
+
+    forest = cyk.parse(std::string(200, 'a'));
+    EXPECT_EQ(forest.treeCount(), std::numeric_limits<std::uint64_t>::max());
+    EXPECT_EQ(forest.tree(12345).nodes[forest.tree(12345).root].size, 200);
+}
+
+TEST(ParseForest, NormalizedDerivations) {
+    ContextFreeGrammar grammar({'a', 'b'}, {'S'}, 'S', {{"S", "aSb"}, {"S", ""}});
+    CYK cyk(grammar);
+
+    auto forest = cyk.parse("aabb");
+    ASSERT_EQ(forest.treeCount(), 1);
+    auto tree = forest.normalizedTree();
+    for (auto const& node: tree.nodes) {
+        if (node.rule != ParseTree::noRule) {
+            EXPECT_EQ(cyk.grammar().rules()[node.rule].lhs[0], node.symbol);
+            EXPECT_LE(node.children.size(), 2);
+        }
+    }
+    EXPECT_THROW(forest.normalizedTree(1), ParseTreeNotFoundException);
+}
+
+TEST(ParseForest, SourceGrammarDerivations) {
+    ContextFreeGrammar grammar({'a', 'b'}, {'S'}, 'S', {{"S", "aSb"}, {"S", ""}});
+    CYK cyk(grammar);
+
+    auto tree = cyk.parse("aabb").tree();
+    EXPECT_EQ(format(grammar, tree), "S[0,4)(a S[1,3)(a S[2,2)() b) b)");
+    EXPECT_EQ(tree.nodes[tree.root].rule, 0);
+    EXPECT_EQ(format(grammar, cyk.parse("").tree()), "S[0,0)()");
+    EXPECT_TRUE(cyk.parse("abb").empty());
+    EXPECT_EQ(cyk.parse("abb").treeCount(), 0);
+    EXPECT_THROW(cyk.parse("abb").tree(), ParseTreeNotFoundException);
+
+    grammar = ContextFreeGrammar(
+        {'a', 'b', 'c'},
+        {'S', 'A', 'B', 'C'},
+        'S',
+        {
+            {"S", "A"}, {"A", "BcCB"}, {"A", "Ca"},
+            {"B", "b"}, {"B", ""}, {"C", "B"}, {"C", "Cc"}
+        }
+    );
+    cyk = CYK(grammar);
+    EXPECT_EQ(
+        format(grammar, cyk.parse("bcb").tree()),
+        "S[0,3)(A[0,3)(B[0,1)(b) c C[2,3)(B[2,3)(b)) B[3,3)()))"
+    );
+    EXPECT_EQ(
+        format(grammar, cyk.parse("c").tree()),
+        "S[0,1)(A[0,1)(B[0,0)() c C[1,1)(B[1,1)()) B[1,1)()))"
+    );
+    EXPECT_EQ(
+        format(grammar, cyk.parse("bcca").tree()),
+        "S[0,4)(A[0,4)(C[0,3)(C[0,2)(C[0,1)(B[0,1)(b)) c) c) a))"
+    );
+}
+
+TEST(ParseForest, RestoredTreesAreSourceDerivations) {
+    std::vector<std::pair<ContextFreeGrammar, std::string>> grammars{
+        {ContextFreeGrammar({'a', 'b'}, {'S'}, 'S', {{"S", "aSb"}, {"S", ""}}), "ab"},
+        {ContextFreeGrammar({'(', ')'}, {'S'}, 'S', {{"S", "SS"}, {"S", "(S)"}, {"S", ""}}), "()"},
+        {
+            ContextFreeGrammar(
+                {'a', 'b', 'c'},
+                {'S', 'A', 'B', 'C'},
+                'S',
+                {
+                    {"S", "A"}, {"A", "BcCB"}, {"A", "Ca"},
+                    {"B", "b"}, {"B", ""}, {"C", "B"}, {"C", "Cc"}
+                }
+            ),
+            "abc"
+        },
+        {
+            ContextFreeGrammar(
+                {'a', 'b'},
+                {'S', 'A', 'B'},
+                'S',
+                {{"S", "AB"}, {"S", "BSA"}, {"A", "B"}, {"A", "a"}, {"B", "A"}, {"B", "b"}, {"B", ""}}
+            ),
+            "ab"
+        }
+    };
+    for (auto const& [grammar, alphabet]: grammars) {
+        CYK cyk(grammar);
+        for (auto const& word: wordsUpTo(alphabet, 5)) {
+            auto forest = cyk.parse(word);
+            EXPECT_EQ(forest.empty(), !cyk.predict(word));
+            for (std::uint64_t i = 0; i < std::min<std::uint64_t>(forest.treeCount(), 16); ++i) {
+                auto tree = forest.tree(i);
+                std::string derivedWord;
+                EXPECT_TRUE(isDerivation(grammar, tree, tree.root, derivedWord)) << word;
+                EXPECT_EQ(derivedWord, word);
+                EXPECT_EQ(tree.nodes[tree.root].symbol, grammar.startSymbol());
+            }
+        }
+    }
+}
+
+TEST(ParseForest, OutlivesRecognizer) {
+    ContextFreeGrammar grammar({'a', 'b'}, {'S'}, 'S', {{"S", "aSb"}, {"S", ""}});
+    auto forest = CYK(grammar).parse("aabb");
+    EXPECT_EQ(format(grammar, forest.tree()), "S[0,4)(a S[1,3)(a S[2,2)() b) b)");
+    EXPECT_EQ(forest.treeCount(), 1);
+}
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <FL/ContextFreeGrammar.hpp>
+#include <FL/RecognitionServer.hpp>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace FL;
+
+namespace {
+
+ContextFreeGrammar const bracketGrammar(
+    {'(', ')'},
+    {'S'},
+    'S',
+    {{"S", "SS"}, {"S", "()"}, {"S", "(S)"}, {"S", ""}}
+);
+
+ContextFreeGrammar const letterGrammar({'a', 'b'}, {'S'}, 'S', {{"S", "aSb"}, {"S", "ab"}});
+
+}
+
+TEST(RecognitionServer, Serve) {
+    std::string socketPath = testing::TempDir() + "flp-server.sock";
+    std::atomic<size_t> loadCount{0};
+    RecognitionServer server({socketPath, 2, 8, std::chrono::microseconds(100)});
+    server.addGrammar("brackets", [] {
+        return bracketGrammar;
+    });
+    server.addGrammar("letters", [&loadCount] {
+        return ++loadCount == 1 ? letterGrammar : bracketGrammar;
+    });
+    std::thread serverThread(&RecognitionServer::run, &server);
+
+    std::vector<std::string> words{"", "()", "(()", "(())()", ")(", "ab", "aabb"};
+    std::vector<bool> expectedResults{true, true, false, true, false, false, false};
+    std::vector<std::thread> clientThreads;
+    for (size_t i = 0; i < 4; ++i) {
+        clientThreads.emplace_back([&] {
+            RecognitionClient client(socketPath);
+            for (size_t j = 0; j < 10; ++j) {
+                EXPECT_EQ(client.check("brackets", words), expectedResults);
+            }
+        });
+    }
+    for (auto& thread: clientThreads) {
+        thread.join();
+    }
+
+    RecognitionClient client(socketPath);
+    EXPECT_TRUE(client.check("letters", "aabb"));
+    EXPECT_FALSE(client.check("letters", "()"));
+    EXPECT_EQ(client.request("RELOAD letters"), "ok");
+    EXPECT_FALSE(client.check("letters", "aabb"));
+    EXPECT_TRUE(client.check("letters", "()"));
+    EXPECT_EQ(client.request("GRAMMARS"), "brackets letters");
+    EXPECT_EQ(client.request("CHECK missing ()").substr(0, 6), "error ");
+    EXPECT_EQ(client.request("UNKNOWN").substr(0, 6), "error ");
+    EXPECT_THROW(client.check("missing", "()"), ServerRequestException);
+    EXPECT_EQ(client.request("STATS").substr(0, 30), "grammar=brackets count=280 p50");
+    EXPECT_EQ(server.latencies("brackets").count(), 280);
+    EXPECT_THROW(server.reloadGrammar("missing"), UnknownGrammarException);
+
+    server.stop();
+    serverThread.join();
+    EXPECT_THROW(RecognitionClient{socketPath}, ServerSocketException);
+}
+
+TEST(RecognitionServer, KeepsNonSocketFiles) {
+    std::string path = testing::TempDir() + "flp-server.bnf";
+    std::ofstream(path) << "S ::= a" << std::endl;
+    EXPECT_THROW(
+        RecognitionServer({path, 1, 8, std::chrono::microseconds(100)}),
+        ServerSocketException
+    );
+    std::ifstream file(path);
+    std::string line;
+    EXPECT_TRUE(std::getline(file, line));
+    EXPECT_EQ(line, "S ::= a");
+    std::remove(path.c_str());
+}
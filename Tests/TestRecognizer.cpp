@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+
+#include <FL/Recognizer.hpp>
+#include <string>
+
+using namespace FL;
+
+namespace {
+
+ContextFreeGrammar const brackets(
+    {'(', ')'},
+    {'S'},
+    'S',
+    {{"S", "(S)S"}, {"S", ""}}
+);
+
+ContextFreeGrammar const ambiguousBrackets(
+    {'(', ')'},
+    {'S'},
+    'S',
+    {{"S", "SS"}, {"S", "(S)"}, {"S", ""}}
+);
+
+}
+
+TEST(Recognizer, Profile) {
+    Recognizer deterministic(brackets);
+    EXPECT_TRUE(deterministic.profile().isDeterministic);
+    EXPECT_EQ(deterministic.profile().reduceReduceConflictCount, 0);
+    EXPECT_TRUE(deterministic.isAvailable(RecognitionStrategy::Deterministic));
+    EXPECT_EQ(deterministic.select(10), RecognitionStrategy::Deterministic);
+
+    Recognizer ambiguous(ambiguousBrackets);
+    auto const& profile = ambiguous.profile();
+    EXPECT_FALSE(profile.isDeterministic);
+    EXPECT_GT(profile.shiftReduceConflictCount + profile.reduceReduceConflictCount, 0);
+    EXPECT_EQ(profile.nonterminalCount, ambiguous.cyk().grammar().nonterminals().size());
+    EXPECT_GT(profile.binaryRuleCount, 0);
+    EXPECT_GT(profile.cellDensity, 0);
+    EXPECT_LT(profile.cellDensity, 1);
+    EXPECT_FALSE(profile.isCalibrated);
+    EXPECT_FALSE(ambiguous.isAvailable(RecognitionStrategy::Deterministic));
+    EXPECT_EQ(ambiguous.select(1), RecognitionStrategy::DenseChart);
+    EXPECT_EQ(ambiguous.select(profile.tiledChartSize), RecognitionStrategy::TiledChart);
+}
+
+TEST(Recognizer, Predict) {
+    RecognizerOptions options;
+    options.calibrates = true;
+    options.maxCalibrationSize = 128;
+    Recognizer recognizer(ambiguousBrackets, options);
+    std::string const words[] = {"", "()", "(()())", "(()", ")(", std::string(300, '(')};
+    for (auto const& word: words) {
+        auto isAccepted = recognizer.cyk().predict(word);
+        EXPECT_EQ(recognizer.predict(word), isAccepted);
+        EXPECT_EQ(recognizer.predict(word, RecognitionStrategy::DenseChart), isAccepted);
+        EXPECT_EQ(recognizer.predict(word, RecognitionStrategy::TiledChart), isAccepted);
+    }
+    EXPECT_THROW(
+        recognizer.predict("()", RecognitionStrategy::Deterministic),
+        UnavailableStrategyException
+    );
+
+    Recognizer deterministic(brackets);
+    for (auto const& word: words) {
+        EXPECT_EQ(
+            deterministic.predict(word, RecognitionStrategy::Deterministic),
+            recognizer.cyk().predict(word)
+        );
+    }
+}
+
+TEST(Recognizer, StatisticsAndOverride) {
+    Recognizer recognizer(brackets);
+    EXPECT_TRUE(recognizer.predict("(())"));
+    EXPECT_FALSE(recognizer.predict("(()"));
+
+    recognizer.overrideStrategy(RecognitionStrategy::TiledChart);
+    EXPECT_EQ(recognizer.select(2), RecognitionStrategy::TiledChart);
+    EXPECT_TRUE(recognizer.predict("()()"));
+    recognizer.overrideStrategy(std::nullopt);
+    EXPECT_EQ(recognizer.select(2), RecognitionStrategy::Deterministic);
+
+    auto statistics = recognizer.statistics();
+    auto deterministic = static_cast<size_t>(RecognitionStrategy::Deterministic);
+    auto tiled = static_cast<size_t>(RecognitionStrategy::TiledChart);
+    EXPECT_EQ(statistics.callCount(), 3);
+    EXPECT_EQ(statistics.callCounts[deterministic], 2);
+    EXPECT_EQ(statistics.symbolCounts[deterministic], 7);
+    EXPECT_EQ(statistics.acceptedCounts[deterministic], 1);
+    EXPECT_EQ(statistics.callCounts[tiled], 1);
+    EXPECT_EQ(statistics.acceptedCounts[tiled], 1);
+
+    recognizer.resetStatistics();
+    EXPECT_EQ(recognizer.statistics().callCount(), 0);
+
+    RecognizerOptions options;
+    options.strategy = RecognitionStrategy::DenseChart;
+    EXPECT_EQ(Recognizer(brackets, options).select(1000), RecognitionStrategy::DenseChart);
+    options.strategy = RecognitionStrategy::Deterministic;
+    EXPECT_THROW(Recognizer(ambiguousBrackets, options), UnavailableStrategyException);
+    EXPECT_STREQ(strategyName(RecognitionStrategy::TiledChart), "tiled chart");
+}
@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+
+#include <FL/ScratchFile.hpp>
+#include <cstdint>
+#include <utility>
+
+using namespace FL;
+
+TEST(ScratchFile, MapAndClear) {
+    ScratchFile scratchFile;
+    EXPECT_EQ(scratchFile.data(), nullptr);
+    EXPECT_EQ(scratchFile.size(), 0);
+
+    scratchFile.map("", 1 << 16);
+    ASSERT_NE(scratchFile.data(), nullptr);
+    EXPECT_EQ(scratchFile.size(), 1 << 16);
+
+    auto values = static_cast<std::uint64_t*>(scratchFile.data());
+    size_t valueCount = scratchFile.size() / sizeof(std::uint64_t);
+    for (size_t i = 0; i < valueCount; ++i) {
+        EXPECT_EQ(values[i], 0);
+        values[i] = i;
+    }
+    scratchFile.prefetch(values + 100, 1000);
+    EXPECT_EQ(values[valueCount - 1], valueCount - 1);
+
+    scratchFile.clear();
+    for (size_t i = 0; i < valueCount; ++i) {
+        EXPECT_EQ(values[i], 0);
+    }
+
+    ScratchFile movedScratchFile = std::move(scratchFile);
+    EXPECT_EQ(scratchFile.data(), nullptr);
+    EXPECT_EQ(movedScratchFile.data(), values);
+}
+
+TEST(ScratchFile, ExceptionMessages) {
+    ScratchFile scratchFile;
+    EXPECT_THROW(scratchFile.map("/nonexistent/directory", 1024), ScratchFileException);
+
+    try {
+        scratchFile.map("/nonexistent/directory", 1024);
+    } catch (ScratchFileException const& exception) {
+        EXPECT_NO_THROW(exception.what());
+    }
+}
@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+
+#include <FL/ContextFreeGrammar.hpp>
+#include <FL/SearchCYK.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace FL;
+
+TEST(SearchCYK, AllMatches) {
+    ContextFreeGrammar grammar({'(', ')'}, {'S'}, 'S', {{"S", "SS"}, {"S", "()"}, {"S", "(S)"}});
+    std::string text = "x(()())((y)()(()))(";
+    for (size_t maxMatchSize: {1, 2, 4, 7, 64}) {
+        SearchCYK searcher(grammar, {maxMatchSize, MatchSemantics::All});
+        std::vector<Match> expectedMatches;
+        for (size_t end = 0; end < text.size(); ++end) {
+            for (size_t size = 1; size <= std::min(maxMatchSize, end + 1); ++size) {
+                if (searcher.predict(text.substr(end - size + 1, size))) {
+                    expectedMatches.push_back({end - size + 1, size});
+                }
+            }
+        }
+        EXPECT_EQ(searcher.search(text), expectedMatches);
+    }
+}
+
+TEST(SearchCYK, LeftmostLongestMatches) {
+    ContextFreeGrammar grammar({'(', ')'}, {'S'}, 'S', {{"S", "SS"}, {"S", "()"}, {"S", "(S)"}});
+    std::string text = "x(()())((y)()(()))(";
+
+    SearchCYK searcher(grammar);
+    std::vector<Match> expectedMatches{{1, 6}, {11, 6}};
+    EXPECT_EQ(searcher.search(text), expectedMatches);
+
+    searcher = SearchCYK(grammar, {4});
+    expectedMatches = {{2, 4}, {11, 2}, {13, 4}};
+    EXPECT_EQ(searcher.search(text), expectedMatches);
+
+    text.clear();
+    for (size_t i = 0; i < 20000; ++i) {
+        text += i % 3 ? "(()" : "(())";
+    }
+    std::stringstream input(text);
+    std::vector<Match> matches;
+    searcher = SearchCYK(grammar, {16});
+    searcher.search(input, [&matches](Match const& match) {
+        matches.push_back(match);
+    });
+    EXPECT_EQ(matches, searcher.search(text));
+
+    EXPECT_THROW(SearchCYK(grammar, {0}), InvalidSearchWindowException);
+}
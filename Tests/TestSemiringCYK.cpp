@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <FL/ContextFreeGrammar.hpp>
+#include <FL/SemiringCYK.hpp>
+#include <string>
+
+using namespace FL;
+
+TEST(SemiringCYK, Boolean) {
+    ContextFreeGrammar grammar({'(', ')'}, {'S'}, 'S', {{"S", "SS"}, {"S", ""}, {"S", "(S)"}});
+    CYK cyk(grammar);
+    SemiringCYK<BooleanSemiring> booleanCYK(grammar);
+    for (std::string word: {"", "()", "(()", "(())()()(((())()()))", "())(()"}) {
+        EXPECT_EQ(booleanCYK.evaluate(word), cyk.predict(word));
+    }
+}
+
+TEST(SemiringCYK, Counting) {
+    ContextFreeGrammar grammar({'a'}, {'S'}, 'S', {{"S", "SS"}, {"S", "a"}});
+    std::vector<std::uint64_t> catalanNumbers = {1, 1, 2, 5, 14, 42, 132, 429, 1430, 4862};
+    for (auto layout: {ChartLayout::Square, ChartLayout::TriangularTiled}) {
+        CYKOptions options;
+        options.layout = layout;
+        SemiringCYK<CountingSemiring> countingCYK(grammar, options);
+        EXPECT_EQ(countingCYK.evaluate(""), 0);
+        for (size_t i = 0; i < catalanNumbers.size(); ++i) {
+            EXPECT_EQ(countingCYK.evaluate(std::string(i + 1, 'a')), catalanNumbers[i]);
+        }
+    }
+
+    grammar = ContextFreeGrammar(
+        {'a', 'b'},
+        {'S', 'A', 'B'},
+        'S',
+        {{"S", "AB"}, {"S", "BA"}, {"A", "a"}, {"B", "b"}, {"S", ""}}
+    );
+    SemiringCYK<CountingSemiring> countingCYK(grammar);
+    EXPECT_EQ(countingCYK.evaluate(""), 1);
+    EXPECT_EQ(countingCYK.evaluate("ab"), 1);
+    EXPECT_EQ(countingCYK.evaluate("ba"), 1);
+    EXPECT_EQ(countingCYK.evaluate("aa"), 0);
+    EXPECT_EQ(countingCYK.evaluate("c"), 0);
+
+    CYKOptions options;
+    options.maxInMemoryChartSize = 4;
+    EXPECT_THROW(
+        SemiringCYK<CountingSemiring>(grammar, options),
+        UnsupportedSemiringOptionsException
+    );
+    EXPECT_TRUE(SemiringCYK<BooleanSemiring>(grammar, options).evaluate("ab"));
+    options.maxInMemoryChartSize = 0;
+    options.memoizeRepeatedSubwords = true;
+    EXPECT_THROW(
+        SemiringCYK<ViterbiSemiring>(grammar, options),
+        UnsupportedSemiringOptionsException
+    );
+}
+
+TEST(SemiringCYK, ViterbiAndKBest) {
+    ContextFreeGrammar grammar({'a'}, {'S'}, 'S', {{"S", "SS"}, {"S", "a"}});
+    SemiringCYK<ViterbiSemiring> viterbiCYK(grammar);
+    EXPECT_EQ(viterbiCYK.evaluate("aaaa"), ViterbiSemiring::one());
+    EXPECT_EQ(viterbiCYK.evaluate("aaba"), ViterbiSemiring::zero());
+
+    SemiringCYK<KBestSemiring<3>> kBestCYK(grammar);
+    auto values = kBestCYK.evaluate("aa");
+    EXPECT_EQ(values[0], ViterbiSemiring::one());
+    EXPECT_EQ(values[1], ViterbiSemiring::zero());
+    values = kBestCYK.evaluate("aaaa");
+    for (auto value: values) {
+        EXPECT_EQ(value, ViterbiSemiring::one());
+    }
+    EXPECT_EQ(kBestCYK.evaluate("b"), KBestSemiring<3>::zero());
+}
+
+TEST(SemiringCYK, KBestOperations) {
+    using Semiring = KBestSemiring<3>;
+    Semiring::Value lhs = {-1, -2, -5};
+    Semiring::Value rhs = {-1.5, -3, ViterbiSemiring::zero()};
+    EXPECT_EQ(Semiring::plus(lhs, rhs), (Semiring::Value{-1, -1.5, -2}));
+    EXPECT_EQ(Semiring::times(lhs, rhs), (Semiring::Value{-2.5, -3.5, -4}));
+    EXPECT_EQ(Semiring::times(lhs, Semiring::one()), lhs);
+    EXPECT_EQ(Semiring::plus(lhs, Semiring::zero()), lhs);
+    EXPECT_EQ(Semiring::times(lhs, Semiring::zero()), Semiring::zero());
+}
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#include <FL/CYK.hpp>
+#include <FL/StaticCYK.hpp>
+#include <string>
+#include <vector>
+
+using namespace FL;
+
+namespace {
+
+struct Brackets {
+    static constexpr char terminals[] = "()";
+    static constexpr char nonterminals[] = "S";
+    static constexpr char startSymbol = 'S';
+    static constexpr StaticRule rules[] = {{'S', "SS"}, {'S', "()"}, {'S', "(S)"}, {'S', ""}};
+};
+
+struct Expressions {
+    static constexpr char terminals[] = "a+*()";
+    static constexpr char nonterminals[] = "ETF";
+    static constexpr char startSymbol = 'E';
+    static constexpr StaticRule rules[] = {
+        {'E', "E+T"},
+        {'E', "T"},
+        {'T', "T*F"},
+        {'T', "F"},
+        {'F', "(E)"},
+        {'F', "a"}
+    };
+};
+
+struct Palindromes {
+    static constexpr char terminals[] = "ab";
+    static constexpr char nonterminals[] = "SABU";
+    static constexpr char startSymbol = 'S';
+    static constexpr StaticRule rules[] = {
+        {'S', "aSa"},
+        {'S', "bSb"},
+        {'S', "A"},
+        {'A', "a"},
+        {'A', "b"},
+        {'A', "B"},
+        {'B', ""},
+        {'U', "aU"}
+    };
+};
+
+template<typename Definition>
+void expectAgreesWithCYK(std::string const& alphabet, size_t maxSize) {
+    CYK cyk(StaticGrammar<Definition>::contextFreeGrammar());
+    std::vector<std::string> words{""};
+    typename StaticCYK<Definition>::Workspace workspace;
+    for (size_t i = 0; i < words.size(); ++i) {
+        EXPECT_EQ(StaticCYK<Definition>::predict(words[i], workspace), cyk.predict(words[i]))
+            << words[i];
+        if (words[i].size() < maxSize) {
+            for (char symbol: alphabet) {
+                words.push_back(words[i] + symbol);
+            }
+        }
+    }
+}
+
+}
+
+TEST(StaticCYK, Normalization) {
+    static_assert(StaticGrammar<Brackets>::acceptsEmptyWord);
+    static_assert(!StaticGrammar<Expressions>::acceptsEmptyWord);
+    static_assert(StaticGrammar<Palindromes>::acceptsEmptyWord);
+    static_assert(StaticGrammar<Palindromes>::nonterminalCount < 8);
+    for (auto const& rule: StaticGrammar<Expressions>::binaryRules) {
+        EXPECT_LT(rule.lhs, StaticGrammar<Expressions>::nonterminalCount);
+        EXPECT_LT(rule.left, StaticGrammar<Expressions>::nonterminalCount);
+        EXPECT_LT(rule.right, StaticGrammar<Expressions>::nonterminalCount);
+    }
+}
+
+TEST(StaticCYK, AgreesWithCYK) {
+    expectAgreesWithCYK<Brackets>("()a", 7);
+    expectAgreesWithCYK<Expressions>("a+*()", 5);
+    expectAgreesWithCYK<Palindromes>("ab", 9);
+    EXPECT_FALSE(StaticCYK<Brackets>::predict(Word{Symbol(1000)}));
+}
@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+
+#include <FL/ContextFreeGrammar.hpp>
+#include <FL/CYK.hpp>
+#include <FL/SymbolSequence.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace FL;
+
+TEST(SymbolSequence, Views) {
+    std::string text = "xyzzy";
+    std::string_view textView(text.data() + 1, 3);
+    SymbolSequence sequence(textView);
+    ASSERT_EQ(sequence.size(), 3);
+    EXPECT_EQ(sequence[0], Symbol('y'));
+    EXPECT_TRUE(SymbolSequence(text).subwordsAreEqual(2, 3, 1));
+    EXPECT_FALSE(SymbolSequence(text).subwordsAreEqual(1, 3, 2));
+    EXPECT_TRUE(SymbolSequence("").empty());
+
+    Word word{1000, 'a', 1000, 'a'};
+    sequence = SymbolSequence(word.data() + 2, 2);
+    EXPECT_EQ(sequence[0], Symbol(1000));
+    EXPECT_TRUE(SymbolSequence(word).subwordsAreEqual(0, 2, 2));
+
+    std::vector<Symbol> byteSymbols(256, Symbol(-1));
+    byteSymbols['0'] = byteSymbols['1'] = 'a';
+    unsigned char bytes[] = {'0', '1', 0xff};
+    sequence = SymbolSequence(bytes, sizeof(bytes), byteSymbols.data());
+    EXPECT_EQ(sequence[0], Symbol('a'));
+    EXPECT_EQ(sequence[1], Symbol('a'));
+    EXPECT_EQ(sequence[2], Symbol(-1));
+}
+
+TEST(SymbolSequence, Recognition) {
+    ContextFreeGrammar grammar({'a', 'b'}, {'S'}, 'S', {{"S", "aSb"}, {"S", "ab"}});
+    CYKOptions options;
+    options.memoizeRepeatedSubwords = true;
+    CYK cyk(grammar, options);
+
+    std::string buffer = "--aaabbb--";
+    EXPECT_TRUE(cyk.predict(std::string_view(buffer).substr(2, 6)));
+    EXPECT_TRUE(cyk.predict(std::string_view(buffer).substr(3, 4)));
+    EXPECT_FALSE(cyk.predict(std::string_view(buffer).substr(2, 5)));
+
+    std::vector<Symbol> byteSymbols(256, Symbol(0));
+    byteSymbols['('] = 'a';
+    byteSymbols[')'] = 'b';
+    std::string bytes = "((()))";
+    EXPECT_TRUE(cyk.predict({bytes.data(), bytes.size(), byteSymbols.data()}));
+    bytes = "(()))(";
+    EXPECT_FALSE(cyk.predict({bytes.data(), bytes.size(), byteSymbols.data()}));
+}
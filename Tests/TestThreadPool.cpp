@@ -0,0 +1,21 @@
+#include <gtest/gtest.h>
+
+#include <FL/ThreadPool.hpp>
+#include <atomic>
+
+using namespace FL;
+
+TEST(ThreadPool, Submit) {
+    std::atomic<size_t> sum{0};
+    {
+        ThreadPool pool(3);
+        EXPECT_EQ(pool.threadCount(), 3);
+        for (size_t i = 1; i <= 100; ++i) {
+            pool.submit([&sum, i] {
+                sum += i;
+            });
+        }
+    }
+    EXPECT_EQ(sum, 5050);
+    EXPECT_GE(ThreadPool().threadCount(), 1);
+}
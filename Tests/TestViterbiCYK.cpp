@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include <FL/ContextFreeGrammar.hpp>
+#include <FL/ViterbiCYK.hpp>
+#include <cmath>
+#include <string>
+
+using namespace FL;
+
+TEST(ViterbiCYK, BestDerivationProbability) {
+    ContextFreeGrammar grammar(
+        {'a'},
+        {'S', 'A'},
+        'S',
+        {{"S", "SS", 0.3}, {"S", "a", 0.5}, {"S", "A", 0.2}, {"A", "a", 1}}
+    );
+    ViterbiCYK cyk(grammar);
+    EXPECT_FLOAT_EQ(cyk.logProbability("a"), std::log(0.5f));
+    EXPECT_FLOAT_EQ(cyk.logProbability("aa"), std::log(0.075f));
+    EXPECT_FLOAT_EQ(cyk.logProbability("aaa"), std::log(0.3f * 0.3f * 0.125f));
+    EXPECT_EQ(cyk.logProbability("b"), ViterbiSemiring::zero());
+    EXPECT_EQ(cyk.logProbability(""), ViterbiSemiring::zero());
+
+    grammar = ContextFreeGrammar({'a', 'b'}, {'S'}, 'S', {{"S", "aSb", 0.6}, {"S", "", 0.4}});
+    cyk = ViterbiCYK(grammar);
+    EXPECT_FLOAT_EQ(cyk.logProbability(""), std::log(0.4f));
+    EXPECT_FLOAT_EQ(cyk.logProbability("ab"), std::log(0.24f));
+    EXPECT_FLOAT_EQ(cyk.logProbability("aabb"), std::log(0.144f));
+    EXPECT_EQ(cyk.logProbability("aab"), ViterbiSemiring::zero());
+}
+
+TEST(ViterbiCYK, Pruning) {
+    ContextFreeGrammar grammar(
+        {'a', 'b'},
+        {'S', 'A', 'B'},
+        'S',
+        {
+            {"S", "AB", 0.9}, {"S", "BA", 0.1},
+            {"A", "a", 0.99}, {"A", "b", 0.01},
+            {"B", "b", 0.99}, {"B", "a", 0.01}
+        }
+    );
+    ViterbiCYK cyk(grammar);
+    EXPECT_FLOAT_EQ(cyk.logProbability("ab"), std::log(0.9f * 0.99f * 0.99f));
+    EXPECT_FLOAT_EQ(cyk.logProbability("ba"), std::log(0.1f * 0.99f * 0.99f));
+
+    ViterbiOptions options;
+    options.beamWidth = 1;
+    ViterbiCYK beamCYK(grammar, options);
+    EXPECT_FLOAT_EQ(beamCYK.logProbability("ab"), std::log(0.9f * 0.99f * 0.99f));
+    EXPECT_FLOAT_EQ(beamCYK.logProbability("ba"), std::log(0.1f * 0.99f * 0.99f));
+    EXPECT_EQ(beamCYK.viterbiOptions().beamWidth, 1);
+
+    options = {};
+    options.threshold = std::log(0.5f);
+    ViterbiCYK thresholdCYK(grammar, options);
+    EXPECT_FLOAT_EQ(thresholdCYK.logProbability("ab"), std::log(0.9f * 0.99f * 0.99f));
+    EXPECT_EQ(thresholdCYK.logProbability("ba"), ViterbiSemiring::zero());
+    EXPECT_EQ(thresholdCYK.evaluate("ba"), ViterbiSemiring::zero());
+
+    grammar = ContextFreeGrammar(
+        {'a'},
+        {'S', 'A', 'B'},
+        'S',
+        {{"S", "AA", 0.5}, {"S", "BB", 0.5}, {"A", "a", 0.9}, {"B", "a", 0.1}}
+    );
+    options = {};
+    options.beamWidth = 1;
+    ViterbiCYK prunedCYK(grammar, options);
+    ViterbiCYK exactCYK(grammar);
+    EXPECT_FLOAT_EQ(prunedCYK.logProbability("aa"), exactCYK.logProbability("aa"));
+    EXPECT_FLOAT_EQ(prunedCYK.logProbability("aa"), std::log(0.5f * 0.9f * 0.9f));
+    EXPECT_EQ(prunedCYK.evaluate("aa"), prunedCYK.logProbability("aa"));
+    CYK::Workspace workspace;
+    EXPECT_EQ(prunedCYK.evaluate("aa", workspace), prunedCYK.logProbability("aa"));
+}
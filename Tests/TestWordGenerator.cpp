@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+
+#include <FL/CYK.hpp>
+#include <FL/WordGenerator.hpp>
+#include <cmath>
+#include <set>
+#include <sstream>
+#include <string>
+
+using namespace FL;
+
+namespace {
+
+ContextFreeGrammar const brackets(
+    {'(', ')'},
+    {'S'},
+    'S',
+    {{"S", "(S)S"}, {"S", ""}}
+);
+
+ContextFreeGrammar const palindromes(
+    {'a', 'b'},
+    {'S'},
+    'S',
+    {{"S", "aSa"}, {"S", "bSb"}, {"S", "a"}, {"S", "b"}}
+);
+
+}
+
+TEST(WordGenerator, DerivationCount) {
+    WordGenerator generator(brackets, 20);
+    EXPECT_EQ(generator.alphabet(), "()");
+    EXPECT_TRUE(generator.hasWords(0));
+    EXPECT_FALSE(generator.hasWords(7));
+    EXPECT_FALSE(generator.hasWords(22));
+
+    double const catalan[] = {1, 1, 2, 5, 14, 42, 132, 429, 1430, 4862, 16796};
+    for (size_t size = 0; size <= 20; size += 2) {
+        EXPECT_NEAR(std::exp(generator.logDerivationCount(size)), catalan[size / 2], 1e-6);
+    }
+
+    WordGenerator palindromeGenerator(palindromes, 9);
+    EXPECT_FALSE(palindromeGenerator.hasWords(0));
+    EXPECT_NEAR(std::exp(palindromeGenerator.logDerivationCount(9)), 32, 1e-9);
+}
+
+TEST(WordGenerator, Generate) {
+    CYK cyk(brackets);
+    WordGenerator generator(brackets, 16);
+    WordGenerator::Random random(1);
+
+    std::set<std::string> words;
+    for (size_t i = 0; i < 2000; ++i) {
+        auto word = generator.generate(8, random);
+        EXPECT_EQ(word.size(), 8);
+        EXPECT_TRUE(cyk.predict(word));
+        words.insert(word);
+    }
+    EXPECT_EQ(words.size(), 14);
+    EXPECT_EQ(generator.generate(0, random), "");
+    EXPECT_THROW(generator.generate(5, random), NoWordsOfSizeException);
+    EXPECT_THROW(generator.generate(18, random), NoWordsOfSizeException);
+    EXPECT_THROW(
+        WordGenerator(ContextFreeGrammar({1000}, {'S'}, 'S', {{Word{'S'}, Word{1000}}}), 4),
+        NonByteAlphabetException
+    );
+}
+
+TEST(WordGenerator, NearMiss) {
+    CYK cyk(palindromes);
+    WordGenerator generator(palindromes, 12);
+    WordGenerator::Random random(2);
+
+    std::string word;
+    size_t rejectedCount = 0;
+    for (size_t i = 0; i < 1000; ++i) {
+        generator.generateNearMiss(9, random, word);
+        EXPECT_EQ(word.size(), 9);
+        rejectedCount += !cyk.predict(word);
+    }
+    EXPECT_GT(rejectedCount, 900);
+}
+
+TEST(WordGenerator, WriteCorpus) {
+    CYK cyk(brackets);
+    WordGenerator generator(brackets, 33);
+    CorpusOptions options;
+    options.wordCount = 5000;
+    options.minWordSize = 2;
+    options.maxWordSize = 32;
+    options.negativeRatio = 0.25;
+    options.writesLabels = true;
+    options.seed = 7;
+    options.wordsPerChunk = 300;
+
+    std::ostringstream corpus;
+    options.threadCount = 1;
+    auto report = generator.writeCorpus(corpus, options, &cyk);
+    EXPECT_EQ(report.wordCount, 5000);
+    EXPECT_GT(report.negativeCount, 1000);
+    EXPECT_LT(report.negativeCount, 1500);
+    EXPECT_EQ(report.byteCount, corpus.str().size());
+
+    std::istringstream lines(corpus.str());
+    std::string line;
+    size_t lineCount = 0;
+    while (std::getline(lines, line)) {
+        auto separator = line.find('\t');
+        ASSERT_NE(separator, std::string::npos);
+        EXPECT_EQ(cyk.predict(line.substr(0, separator)), line.substr(separator + 1) == "1");
+        ++lineCount;
+    }
+    EXPECT_EQ(lineCount, 5000);
+
+    std::ostringstream parallelCorpus;
+    options.threadCount = 3;
+    generator.writeCorpus(parallelCorpus, options, &cyk);
+    EXPECT_EQ(parallelCorpus.str(), corpus.str());
+
+    EXPECT_THROW(generator.writeCorpus(corpus, options), UnverifiedLabelsException);
+    options.writesLabels = false;
+    EXPECT_NO_THROW(generator.writeCorpus(parallelCorpus, options));
+
+    options.minWordSize = 3;
+    options.maxWordSize = 3;
+    EXPECT_THROW(generator.writeCorpus(corpus, options), NoWordsOfSizeException);
+}